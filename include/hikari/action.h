@@ -23,4 +23,9 @@ hikari_action_parse(struct hikari_action *action,
     struct wl_list *action_configs,
     const ucl_object_t *action_obj);
 
+bool
+hikari_action_resolve(struct hikari_event_action *event_action,
+    struct wl_list *action_configs,
+    const char *action_name);
+
 #endif
@@ -0,0 +1,39 @@
+#if !defined(HIKARI_ANIMATION_H)
+#define HIKARI_ANIMATION_H
+
+#include <time.h>
+
+#include <wayland-util.h>
+#include <wlr/util/box.h>
+
+struct hikari_output;
+struct hikari_view;
+
+struct hikari_animation {
+  struct hikari_view *view;
+  struct hikari_output *output;
+
+  struct wlr_box from;
+  struct wlr_box box;
+  struct wlr_box damage;
+
+  struct timespec start;
+  int duration;
+
+  struct wl_list server_animations;
+};
+
+void
+hikari_animation_start(struct hikari_view *view, struct wlr_box *from);
+
+void
+hikari_animation_cancel(struct hikari_view *view);
+
+void
+hikari_animations_frame(
+    struct hikari_output *output, const struct timespec *now);
+
+void
+hikari_animations_cancel(struct hikari_output *output);
+
+#endif
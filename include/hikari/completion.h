@@ -1,26 +1,22 @@
 #if !defined(HIKARI_COMPLETION_H)
 #define HIKARI_COMPLETION_H
 
-#include <wayland-util.h>
-
-struct hikari_completion_item {
-  char data[256];
-  struct wl_list completion_items;
-};
+struct hikari_group_trie;
+struct hikari_group_trie_node;
 
 struct hikari_completion {
-  struct hikari_completion_item *current_item;
-  struct wl_list items;
-};
+  struct hikari_group_trie *trie;
+  struct hikari_group_trie_node *prefix;
+  struct hikari_group_trie_node *current;
+  unsigned long generation;
 
-void
-hikari_completion_init(struct hikari_completion *completion, char *data);
-
-void
-hikari_completion_fini(struct hikari_completion *completion);
+  char input[256];
+};
 
 void
-hikari_completion_add(struct hikari_completion *completion, char *data);
+hikari_completion_init(struct hikari_completion *completion,
+    struct hikari_group_trie *trie,
+    char *input);
 
 char *
 hikari_completion_cancel(struct hikari_completion *completion);
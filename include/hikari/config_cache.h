@@ -0,0 +1,65 @@
+#if !defined(HIKARI_CONFIG_CACHE_H)
+#define HIKARI_CONFIG_CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <ucl.h>
+
+#include <hikari/configuration.h>
+
+struct hikari_config_cache_header {
+  char magic[8];
+  uint64_t dev;
+  uint64_t ino;
+  uint64_t source_size;
+  uint64_t mtime_sec;
+  uint64_t mtime_nsec;
+  uint64_t ctime_sec;
+  uint64_t ctime_nsec;
+  uint64_t env_hash;
+  uint64_t sections[HIKARI_NR_OF_CONFIGURATION_SECTIONS];
+  uint64_t names_size;
+  uint64_t payload_size;
+};
+
+struct hikari_config_cache {
+  char *path;
+  char *config_path;
+  bool cacheable;
+
+  void *data;
+  size_t size;
+
+  struct hikari_config_cache_header header;
+};
+
+void
+hikari_config_cache_init(
+    struct hikari_config_cache *cache, const char *config_path);
+
+void
+hikari_config_cache_fini(struct hikari_config_cache *cache);
+
+ucl_object_t *
+hikari_config_cache_load(struct hikari_config_cache *cache, uint64_t *sections);
+
+uint64_t
+hikari_config_cache_hash_object(const ucl_object_t *obj);
+
+void
+hikari_config_cache_store(struct hikari_config_cache *cache,
+    const ucl_object_t *configuration_obj,
+    const uint64_t *sections);
+
+char *
+hikari_config_cache_file(const char *name);
+
+uint64_t
+hikari_config_cache_hash(const void *data, size_t size);
+
+void
+hikari_config_cache_write_file(const char *path, const void *data, size_t size);
+
+#endif
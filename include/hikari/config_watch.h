@@ -0,0 +1,51 @@
+#if !defined(HIKARI_CONFIG_WATCH_H)
+#define HIKARI_CONFIG_WATCH_H
+
+#include <stdint.h>
+
+#include <wayland-server-core.h>
+#include <wayland-util.h>
+
+static const int HIKARI_CONFIG_WATCH_DEBOUNCE = 250;
+
+enum hikari_config_watch_kind {
+  HIKARI_CONFIG_WATCH_KIND_CONFIGURATION = 1 << 0,
+  HIKARI_CONFIG_WATCH_KIND_KEYMAP = 1 << 1,
+  HIKARI_CONFIG_WATCH_KIND_BACKGROUND = 1 << 2,
+  HIKARI_CONFIG_WATCH_KIND_XKB = 1 << 3
+};
+
+struct hikari_config_watch_entry {
+  struct wl_list link;
+
+  int wd;
+  // NULL matches every file in the directory
+  char *name;
+  enum hikari_config_watch_kind kind;
+};
+
+struct hikari_config_watch {
+  int fd;
+  uint32_t pending;
+
+  struct wl_list entries;
+  struct wl_list xkb_entries;
+
+  struct wl_event_source *event_source;
+  struct wl_event_source *debounce;
+};
+
+void
+hikari_config_watch_init(
+    struct hikari_config_watch *watch, struct wl_event_loop *event_loop);
+
+void
+hikari_config_watch_fini(struct hikari_config_watch *watch);
+
+void
+hikari_config_watch_update(struct hikari_config_watch *watch);
+
+void
+hikari_config_watch_resume(struct hikari_config_watch *watch);
+
+#endif
@@ -15,6 +15,21 @@ struct hikari_sheet;
 struct hikari_view;
 struct hikari_pointer_config;
 
+enum hikari_configuration_section {
+  HIKARI_CONFIGURATION_SECTION_UI,
+  HIKARI_CONFIGURATION_SECTION_ACTIONS,
+  HIKARI_CONFIGURATION_SECTION_LAYOUTS,
+  HIKARI_CONFIGURATION_SECTION_VIEWS,
+  HIKARI_CONFIGURATION_SECTION_MARKS,
+  HIKARI_CONFIGURATION_SECTION_BINDINGS,
+  HIKARI_CONFIGURATION_SECTION_OUTPUTS,
+  HIKARI_CONFIGURATION_SECTION_POINTERS,
+  HIKARI_CONFIGURATION_SECTION_KEYBOARDS,
+  HIKARI_CONFIGURATION_SECTION_SWITCHES,
+  HIKARI_CONFIGURATION_SECTION_IDLE,
+  HIKARI_NR_OF_CONFIGURATION_SECTIONS
+};
+
 struct hikari_configuration {
   float clear[4];
   float foreground[4];
@@ -31,6 +46,10 @@ struct hikari_configuration {
   int border;
   int gap;
   int step;
+  int animation_duration;
+
+  int idle_standby;
+  int idle_power_off;
 
   struct hikari_exec execs[HIKARI_NR_OF_EXECS];
 
@@ -43,6 +62,8 @@ struct hikari_configuration {
   struct wl_list keyboard_binding_configs;
   struct wl_list mouse_binding_configs;
   struct wl_list switch_configs;
+
+  uint64_t sections[HIKARI_NR_OF_CONFIGURATION_SECTIONS];
 };
 
 extern struct hikari_configuration *hikari_configuration;
@@ -60,6 +81,10 @@ hikari_configuration_load(
 bool
 hikari_configuration_reload(char *config_path);
 
+void
+hikari_configuration_invalidate(struct hikari_configuration *configuration,
+    enum hikari_configuration_section section);
+
 struct hikari_view_config *
 hikari_configuration_resolve_view_config(
     struct hikari_configuration *configuration, const char *app_id);
@@ -12,6 +12,11 @@ struct hikari_cursor {
   struct wlr_cursor *wlr_cursor;
   struct wlr_xcursor_manager *cursor_mgr;
 
+  const char *image;
+  struct wlr_surface *surface;
+  int32_t hotspot_x;
+  int32_t hotspot_y;
+
   struct wl_listener motion_absolute;
   struct wl_listener motion;
   struct wl_listener frame;
@@ -0,0 +1,46 @@
+#if !defined(HIKARI_DAMAGE_OVERLAY_H)
+#define HIKARI_DAMAGE_OVERLAY_H
+
+#include <stdbool.h>
+
+#include <pixman.h>
+#include <wayland-server-core.h>
+
+#define HIKARI_DAMAGE_OVERLAY_LEVELS 4
+
+static const int HIKARI_DAMAGE_OVERLAY_TIMEOUT = 250;
+static const int HIKARI_DAMAGE_OVERLAY_FLASH_WIDTH = 8;
+
+struct hikari_output;
+struct hikari_renderer;
+
+struct hikari_damage_overlay {
+  struct hikari_output *output;
+  struct wl_event_source *expire;
+
+  bool flash;
+
+  pixman_region32_t drawn[HIKARI_DAMAGE_OVERLAY_LEVELS];
+  pixman_region32_t pending;
+  pixman_region32_t repaint;
+};
+
+void
+hikari_damage_overlay_init(
+    struct hikari_damage_overlay *overlay, struct hikari_output *output);
+
+void
+hikari_damage_overlay_fini(struct hikari_damage_overlay *overlay);
+
+void
+hikari_damage_overlay_begin(struct hikari_damage_overlay *overlay);
+
+void
+hikari_damage_overlay_account(
+    struct hikari_damage_overlay *overlay, pixman_region32_t *region);
+
+void
+hikari_damage_overlay_render(
+    struct hikari_damage_overlay *overlay, struct hikari_renderer *renderer);
+
+#endif
@@ -0,0 +1,67 @@
+#if !defined(HIKARI_DAMAGE_RING_H)
+#define HIKARI_DAMAGE_RING_H
+
+#include <stdbool.h>
+
+#include <pixman.h>
+
+#define HIKARI_DAMAGE_RING_SIZE 4
+
+static const int HIKARI_DAMAGE_RING_MAX_RECTS = 20;
+
+enum hikari_damage_ring_mode {
+  HIKARI_DAMAGE_RING_MODE_PARTIAL,
+  HIKARI_DAMAGE_RING_MODE_FULL,
+  HIKARI_DAMAGE_RING_MODE_VALIDATE
+};
+
+struct hikari_damage_ring_frame {
+  pixman_region32_t damage;
+  int buffer_age;
+  bool full;
+};
+
+struct hikari_damage_ring_stats {
+  unsigned long frames;
+  unsigned long full;
+  unsigned long unknown_age;
+  unsigned long validated;
+  unsigned long mismatches;
+};
+
+struct hikari_damage_ring {
+  enum hikari_damage_ring_mode mode;
+
+  struct hikari_damage_ring_frame frames[HIKARI_DAMAGE_RING_SIZE];
+  int head;
+  int nr_of_frames;
+
+  int buffer_age;
+  bool full;
+
+  struct hikari_damage_ring_stats stats;
+};
+
+void
+hikari_damage_ring_init(struct hikari_damage_ring *damage_ring);
+
+void
+hikari_damage_ring_fini(struct hikari_damage_ring *damage_ring);
+
+void
+hikari_damage_ring_buffer_damage(struct hikari_damage_ring *damage_ring,
+    pixman_region32_t *current,
+    int buffer_age,
+    int width,
+    int height,
+    pixman_region32_t *buffer_damage);
+
+void
+hikari_damage_ring_push(
+    struct hikari_damage_ring *damage_ring, pixman_region32_t *damage);
+
+void
+hikari_damage_ring_validated(
+    struct hikari_damage_ring *damage_ring, const char *name, bool matches);
+
+#endif
@@ -0,0 +1,36 @@
+#if !defined(HIKARI_FIND_MODE_H)
+#define HIKARI_FIND_MODE_H
+
+#include <hikari/indicator_bar.h>
+#include <hikari/input_buffer.h>
+#include <hikari/mode.h>
+
+#define HIKARI_FIND_MODE_MAX_RESULTS 10
+
+struct hikari_output;
+struct hikari_view;
+struct wlr_box;
+
+struct hikari_find_mode {
+  struct hikari_mode mode;
+  struct hikari_input_buffer input_buffer;
+
+  struct hikari_view *results[HIKARI_FIND_MODE_MAX_RESULTS];
+  int nr_of_results;
+  int selected;
+  unsigned long generation;
+
+  struct hikari_indicator_bar prompt;
+  struct hikari_indicator_bar entries[HIKARI_FIND_MODE_MAX_RESULTS];
+};
+
+void
+hikari_find_mode_init(struct hikari_find_mode *find_mode);
+
+void
+hikari_find_mode_enter(void);
+
+void
+hikari_find_mode_origin(struct hikari_output *output, struct wlr_box *origin);
+
+#endif
@@ -1,6 +1,9 @@
 #if !defined(HIKARI_GROUP_ASSIGN_MODE_H)
 #define HIKARI_GROUP_ASSIGN_MODE_H
 
+#include <stdbool.h>
+
+#include <hikari/completion.h>
 #include <hikari/input_buffer.h>
 #include <hikari/mode.h>
 
@@ -10,7 +13,8 @@ struct hikari_view;
 struct hikari_group_assign_mode {
   struct hikari_mode mode;
   struct hikari_input_buffer input_buffer;
-  struct hikari_completion *completion;
+  struct hikari_completion completion;
+  bool completing;
   struct hikari_group *group;
 };
 
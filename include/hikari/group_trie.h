@@ -0,0 +1,46 @@
+#if !defined(HIKARI_GROUP_TRIE_H)
+#define HIKARI_GROUP_TRIE_H
+
+struct hikari_group;
+
+struct hikari_group_trie_node {
+  struct hikari_group *group;
+
+  struct hikari_group_trie_node *parent;
+  struct hikari_group_trie_node *children;
+  struct hikari_group_trie_node *next;
+
+  unsigned char key;
+};
+
+struct hikari_group_trie {
+  struct hikari_group_trie_node root;
+  unsigned long generation;
+};
+
+void
+hikari_group_trie_init(struct hikari_group_trie *trie);
+
+void
+hikari_group_trie_fini(struct hikari_group_trie *trie);
+
+void
+hikari_group_trie_insert(
+    struct hikari_group_trie *trie, struct hikari_group *group);
+
+void
+hikari_group_trie_remove(
+    struct hikari_group_trie *trie, struct hikari_group *group);
+
+struct hikari_group_trie_node *
+hikari_group_trie_lookup(struct hikari_group_trie *trie, const char *prefix);
+
+struct hikari_group_trie_node *
+hikari_group_trie_next(struct hikari_group_trie_node *node,
+    struct hikari_group_trie_node *root);
+
+struct hikari_group_trie_node *
+hikari_group_trie_prev(struct hikari_group_trie_node *node,
+    struct hikari_group_trie_node *root);
+
+#endif
@@ -0,0 +1,50 @@
+#if !defined(HIKARI_IDLE_H)
+#define HIKARI_IDLE_H
+
+#include <stdbool.h>
+#include <time.h>
+
+#include <wayland-server-core.h>
+
+struct wlr_idle;
+struct wlr_idle_inhibit_manager_v1;
+
+enum hikari_idle_state {
+  HIKARI_IDLE_STATE_ACTIVE,
+  HIKARI_IDLE_STATE_STANDBY,
+  HIKARI_IDLE_STATE_POWER_OFF
+};
+
+struct hikari_idle {
+  struct wlr_idle *wlr_idle;
+  struct wlr_idle_inhibit_manager_v1 *inhibit_manager;
+
+  struct wl_event_source *timer;
+  struct timespec last_activity;
+  enum hikari_idle_state state;
+  int inhibitors;
+
+  struct wl_listener new_inhibitor;
+};
+
+void
+hikari_idle_init(struct hikari_idle *idle,
+    struct wl_display *display,
+    struct wl_event_loop *event_loop);
+
+void
+hikari_idle_fini(struct hikari_idle *idle);
+
+void
+hikari_idle_configure(struct hikari_idle *idle);
+
+void
+hikari_idle_notify_activity(struct hikari_idle *idle);
+
+static inline bool
+hikari_idle_is_standby(struct hikari_idle *idle)
+{
+  return idle->state != HIKARI_IDLE_STATE_ACTIVE;
+}
+
+#endif
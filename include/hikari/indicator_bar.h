@@ -1,16 +1,21 @@
 #if !defined(HIKARI_INDICATOR_BAR_H)
 #define HIKARI_INDICATOR_BAR_H
 
+#include <stdbool.h>
+
 #include <wlr/types/wlr_surface.h>
 
 struct hikari_indicator;
+struct wlr_renderer;
 struct hikari_renderer;
 struct hikari_output;
 
 struct hikari_indicator_bar {
   struct wlr_texture *texture;
   struct hikari_indicator *indicator;
+  char *text;
 
+  bool dirty;
   int width;
   int offset;
 
@@ -35,6 +40,10 @@ hikari_indicator_bar_update(struct hikari_indicator_bar *indicator_bar,
     struct hikari_output *output,
     const char *text);
 
+void
+hikari_indicator_bar_refresh(struct hikari_indicator_bar *indicator_bar,
+    struct wlr_renderer *wlr_renderer);
+
 void
 hikari_indicator_bar_damage(struct hikari_indicator_bar *indicator_bar,
     struct hikari_output *output,
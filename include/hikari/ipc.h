@@ -0,0 +1,70 @@
+#if !defined(HIKARI_IPC_H)
+#define HIKARI_IPC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <wayland-server-core.h>
+#include <wayland-util.h>
+
+struct hikari_sheet;
+struct hikari_view;
+
+static const size_t HIKARI_IPC_MAX_REQUEST = 4096;
+static const size_t HIKARI_IPC_MAX_PENDING = 1 << 20;
+
+enum hikari_ipc_event {
+  HIKARI_IPC_EVENT_FOCUS = 1 << 0,
+  HIKARI_IPC_EVENT_MAP = 1 << 1,
+  HIKARI_IPC_EVENT_SHEET = 1 << 2
+};
+
+struct hikari_ipc_buffer {
+  char *data;
+  size_t len;
+  size_t size;
+};
+
+struct hikari_ipc_client {
+  struct wl_list link;
+
+  int fd;
+  bool closing;
+  bool disconnect;
+  uint32_t subscriptions;
+
+  struct hikari_ipc_buffer in;
+  struct hikari_ipc_buffer out;
+
+  struct wl_event_source *event_source;
+};
+
+struct hikari_ipc {
+  int fd;
+  char *path;
+
+  struct wl_list clients;
+
+  struct wl_event_loop *event_loop;
+  struct wl_event_source *event_source;
+};
+
+void
+hikari_ipc_init(struct hikari_ipc *ipc,
+    struct wl_event_loop *event_loop,
+    const char *socket_name);
+
+void
+hikari_ipc_fini(struct hikari_ipc *ipc);
+
+void
+hikari_ipc_notify_focus(struct hikari_ipc *ipc, struct hikari_view *view);
+
+void
+hikari_ipc_notify_map(struct hikari_ipc *ipc, struct hikari_view *view);
+
+void
+hikari_ipc_notify_sheet(struct hikari_ipc *ipc, struct hikari_sheet *sheet);
+
+#endif
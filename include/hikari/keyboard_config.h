@@ -37,6 +37,7 @@ struct hikari_keyboard_config {
   struct wl_list link;
 
   char *keyboard_name;
+  char *xkb_file;
 
   struct hikari_xkb xkb;
 
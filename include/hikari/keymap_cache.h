@@ -0,0 +1,31 @@
+#if !defined(HIKARI_KEYMAP_CACHE_H)
+#define HIKARI_KEYMAP_CACHE_H
+
+#include <stdio.h>
+
+#include <xkbcommon/xkbcommon.h>
+
+#define HIKARI_KEYMAP_CACHE_SIZE 8
+
+struct hikari_keymap_cache_entry {
+  char *names[5];
+  unsigned long last_used;
+  struct xkb_keymap *keymap;
+};
+
+struct xkb_keymap *
+hikari_keymap_cache_compile(const struct xkb_rule_names *rule_names);
+
+struct xkb_keymap *
+hikari_keymap_cache_load_file(FILE *file);
+
+struct xkb_context *
+hikari_keymap_cache_context(void);
+
+void
+hikari_keymap_cache_invalidate(void);
+
+void
+hikari_keymap_cache_fini(void);
+
+#endif
@@ -23,6 +23,18 @@ struct hikari_layer_node {
   } node;
 };
 
+struct hikari_layer_state {
+  uint32_t anchor;
+  int32_t exclusive_zone;
+  int32_t margin_top;
+  int32_t margin_right;
+  int32_t margin_bottom;
+  int32_t margin_left;
+  uint32_t desired_width;
+  uint32_t desired_height;
+  enum zwlr_layer_shell_v1_layer layer;
+};
+
 struct hikari_layer {
   struct hikari_node node;
 
@@ -37,6 +49,7 @@ struct hikari_layer {
   struct wl_listener new_popup;
 
   struct wlr_box geometry;
+  struct hikari_layer_state state;
 
   struct hikari_output *output;
   enum zwlr_layer_shell_v1_layer layer;
@@ -62,4 +75,7 @@ hikari_layer_init(struct hikari_layer *layer_surface,
 void
 hikari_layer_fini(struct hikari_layer *layer_surface);
 
+void
+hikari_layer_shell_resume(void);
+
 #endif
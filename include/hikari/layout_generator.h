@@ -0,0 +1,88 @@
+#if !defined(HIKARI_LAYOUT_GENERATOR_H)
+#define HIKARI_LAYOUT_GENERATOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+#include <wayland-util.h>
+#include <wlr/util/box.h>
+
+#define HIKARI_LAYOUT_GENERATOR_CACHE_SIZE 8
+
+static const int HIKARI_LAYOUT_GENERATOR_TIMEOUT = 50;
+static const int HIKARI_LAYOUT_GENERATOR_BACKOFF = 5000;
+
+struct wl_event_source;
+
+struct hikari_layout_generator_entry {
+  int nr_of_views;
+  int gap;
+  int border;
+  struct wlr_box frame;
+  struct wlr_box *boxes;
+};
+
+struct hikari_layout_generator_request {
+  uint32_t seq;
+  int nr_of_views;
+  int gap;
+  int border;
+  struct wlr_box frame;
+};
+
+struct hikari_layout_generator_reply {
+  uint32_t seq;
+  int nr_of_boxes;
+  int received;
+  bool header;
+  struct wlr_box *boxes;
+
+  size_t line_len;
+  char line[128];
+};
+
+struct hikari_layout_generator {
+  char *path;
+  int fd;
+  int refs;
+  bool connecting;
+
+  struct wl_event_source *event_source;
+  struct wl_event_source *timeout;
+  struct timespec retry;
+
+  uint32_t seq;
+  bool in_flight;
+  bool queued;
+  struct hikari_layout_generator_request pending;
+  struct hikari_layout_generator_request next;
+  struct hikari_layout_generator_reply reply;
+  bool reapply_pending;
+
+  int next_entry;
+  struct hikari_layout_generator_entry
+      entries[HIKARI_LAYOUT_GENERATOR_CACHE_SIZE];
+
+  struct wl_list generators;
+};
+
+struct hikari_layout_generator *
+hikari_layout_generator_create(const char *path);
+
+struct hikari_layout_generator *
+hikari_layout_generator_ref(struct hikari_layout_generator *generator);
+
+void
+hikari_layout_generator_unref(struct hikari_layout_generator *generator);
+
+bool
+hikari_layout_generator_request(struct hikari_layout_generator *generator,
+    int nr_of_views,
+    struct wlr_box *frame,
+    struct wlr_box *boxes);
+
+void
+hikari_layout_generator_resume(void);
+
+#endif
@@ -6,6 +6,7 @@
 #include <wlr/util/box.h>
 
 #include <hikari/memory.h>
+#include <hikari/slab.h>
 
 struct hikari_view;
 
@@ -26,13 +27,13 @@ hikari_maximized_state_full(struct hikari_view *view, int width, int height);
 static inline struct hikari_maximized_state *
 hikari_maximized_state_alloc(void)
 {
-  return hikari_malloc(sizeof(struct hikari_maximized_state));
+  return hikari_slab_alloc(&hikari_maximized_state_slab);
 }
 
 static inline void
 hikari_maximized_state_destroy(struct hikari_maximized_state *maximized_state)
 {
-  hikari_free(maximized_state);
+  hikari_slab_free(&hikari_maximized_state_slab, maximized_state);
 }
 
 #endif
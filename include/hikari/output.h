@@ -9,16 +9,28 @@
 #include <wlr/types/wlr_output_damage.h>
 #include <wlr/types/wlr_surface.h>
 
+#include <hikari/damage_overlay.h>
+#include <hikari/damage_ring.h>
 #include <hikari/output_config.h>
 
 struct hikari_renderer;
 
+struct hikari_output_cursor_stats {
+  unsigned long hardware;
+  unsigned long software;
+};
+
 struct hikari_output {
   struct wlr_output *wlr_output;
   struct wlr_output_damage *damage;
   struct hikari_workspace *workspace;
 
   bool enabled;
+  bool software_cursor;
+
+  struct hikari_output_cursor_stats cursor_stats;
+  struct hikari_damage_overlay damage_overlay;
+  struct hikari_damage_ring damage_ring;
 
   struct wl_listener damage_frame;
   struct wl_listener destroy;
@@ -27,6 +39,8 @@ struct hikari_output {
 
 #ifdef HAVE_LAYERSHELL
   struct wl_list layers[4];
+  struct wl_event_source *arrange_idle;
+  bool arrange_pending;
 #endif
 
   struct wl_list views;
@@ -56,6 +70,9 @@ hikari_output_disable(struct hikari_output *output);
 void
 hikari_output_enable(struct hikari_output *output);
 
+void
+hikari_output_update_cursor_plane(struct hikari_output *output);
+
 void
 hikari_output_load_background(struct hikari_output *output,
     const char *path,
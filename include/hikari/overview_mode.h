@@ -0,0 +1,55 @@
+#if !defined(HIKARI_OVERVIEW_MODE_H)
+#define HIKARI_OVERVIEW_MODE_H
+
+#include <stdbool.h>
+
+#include <wlr/util/box.h>
+
+#include <hikari/indicator_bar.h>
+#include <hikari/mode.h>
+
+#define HIKARI_OVERVIEW_MODE_REFRESH_MSEC 100
+
+struct hikari_output;
+struct hikari_view;
+
+struct hikari_thumbnail {
+  struct hikari_view *view;
+  struct wlr_box geometry;
+  double scale;
+};
+
+struct hikari_overview_mode {
+  struct hikari_mode mode;
+  struct hikari_output *output;
+
+  struct hikari_thumbnail *thumbnails;
+  int nr_of_thumbnails;
+  int capacity;
+  int columns;
+  int selected;
+  unsigned long generation;
+
+  struct wl_event_source *timer;
+  bool frame_due;
+
+  struct hikari_indicator_bar title;
+};
+
+void
+hikari_overview_mode_init(struct hikari_overview_mode *overview_mode);
+
+void
+hikari_overview_mode_fini(struct hikari_overview_mode *overview_mode);
+
+void
+hikari_overview_mode_enter(void);
+
+void
+hikari_overview_mode_refresh(struct hikari_overview_mode *overview_mode);
+
+bool
+hikari_overview_mode_throttles(
+    struct hikari_overview_mode *overview_mode, struct hikari_output *output);
+
+#endif
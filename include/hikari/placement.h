@@ -0,0 +1,43 @@
+#if !defined(HIKARI_PLACEMENT_H)
+#define HIKARI_PLACEMENT_H
+
+#include <stdint.h>
+
+#include <wayland-util.h>
+#include <wlr/util/box.h>
+
+struct hikari_output;
+struct hikari_split;
+struct hikari_view;
+
+struct hikari_view_placement {
+  struct hikari_view *view;
+  uint8_t sheet_nr;
+  struct wlr_box geometry;
+
+  struct wl_list placement_views;
+};
+
+struct hikari_placement {
+  char *output_name;
+  uint8_t sheet_nr;
+  uint8_t alternate_sheet_nr;
+  struct hikari_split **splits;
+
+  struct wl_list views;
+  struct wl_list server_placements;
+};
+
+void
+hikari_placement_store(struct hikari_output *output);
+
+void
+hikari_placement_restore(struct hikari_output *output);
+
+void
+hikari_placement_forget(struct hikari_view *view);
+
+void
+hikari_placements_fini(void);
+
+#endif
@@ -0,0 +1,130 @@
+#if !defined(HIKARI_RECORDER_H)
+#define HIKARI_RECORDER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include <wayland-server-core.h>
+
+struct wlr_backend;
+struct wlr_event_keyboard_key;
+struct wlr_event_pointer_axis;
+struct wlr_event_pointer_button;
+struct wlr_event_pointer_motion;
+struct wlr_event_pointer_motion_absolute;
+struct wlr_input_device;
+
+static const int HIKARI_RECORDER_REPLAY_DELAY = 1000;
+
+enum hikari_recorder_event_type {
+  HIKARI_RECORDER_EVENT_KEY,
+  HIKARI_RECORDER_EVENT_MOTION,
+  HIKARI_RECORDER_EVENT_MOTION_ABSOLUTE,
+  HIKARI_RECORDER_EVENT_BUTTON,
+  HIKARI_RECORDER_EVENT_AXIS,
+  HIKARI_RECORDER_EVENT_FRAME,
+  HIKARI_RECORDER_EVENT_ACTION,
+  HIKARI_RECORDER_EVENT_MAP,
+  HIKARI_RECORDER_EVENT_COMMIT,
+  HIKARI_RECORDER_EVENT_CONFIGURE
+};
+
+struct hikari_recorder_event {
+  uint32_t time;
+  uint8_t type;
+  uint8_t state;
+  uint8_t source;
+  uint8_t reserved;
+  uint32_t code;
+  int32_t discrete;
+  double x;
+  double y;
+};
+
+struct hikari_recorder_stats {
+  unsigned long frames;
+  uint64_t frame_time;
+  uint64_t max_frame_time;
+};
+
+struct hikari_recorder {
+  FILE *file;
+  struct timespec start;
+
+  struct hikari_recorder_event *events;
+  size_t nr_of_events;
+  size_t next_event;
+
+  struct wl_event_source *timer;
+  struct wlr_backend *backend;
+  struct wlr_input_device *keyboard;
+  struct wlr_input_device *pointer;
+
+  struct hikari_recorder_stats stats;
+};
+
+void
+hikari_recorder_init(struct hikari_recorder *recorder,
+    struct wl_display *display,
+    struct wlr_backend *backend);
+
+void
+hikari_recorder_fini(struct hikari_recorder *recorder);
+
+void
+hikari_recorder_record(struct hikari_recorder *recorder,
+    struct hikari_recorder_event *event);
+
+void
+hikari_recorder_key(
+    struct hikari_recorder *recorder, struct wlr_event_keyboard_key *event);
+
+void
+hikari_recorder_motion(
+    struct hikari_recorder *recorder, struct wlr_event_pointer_motion *event);
+
+void
+hikari_recorder_motion_absolute(struct hikari_recorder *recorder,
+    struct wlr_event_pointer_motion_absolute *event);
+
+void
+hikari_recorder_button(
+    struct hikari_recorder *recorder, struct wlr_event_pointer_button *event);
+
+void
+hikari_recorder_axis(
+    struct hikari_recorder *recorder, struct wlr_event_pointer_axis *event);
+
+void
+hikari_recorder_frame_time(
+    struct hikari_recorder *recorder, struct timespec *start);
+
+static inline bool
+hikari_recorder_is_recording(struct hikari_recorder *recorder)
+{
+  return recorder->file != NULL;
+}
+
+static inline bool
+hikari_recorder_is_replaying(struct hikari_recorder *recorder)
+{
+  return recorder->events != NULL;
+}
+
+static inline void
+hikari_recorder_mark(struct hikari_recorder *recorder,
+    enum hikari_recorder_event_type type,
+    uint32_t code,
+    double x,
+    double y)
+{
+  struct hikari_recorder_event event = {
+    .type = type, .code = code, .x = x, .y = y
+  };
+
+  hikari_recorder_record(recorder, &event);
+}
+
+#endif
@@ -9,6 +9,7 @@
 #include <wlr/render/wlr_renderer.h>
 #include <wlr/types/wlr_output.h>
 
+struct hikari_damage_overlay;
 struct hikari_output;
 
 struct hikari_renderer {
@@ -16,14 +17,23 @@ struct hikari_renderer {
   struct wlr_renderer *wlr_renderer;
   pixman_region32_t *damage;
   struct wlr_box *geometry;
+  struct hikari_damage_overlay *overlay;
 };
 
 void
 hikari_renderer_damage_frame_handler(struct wl_listener *listener, void *);
 
+void
+hikari_renderer_scissor(struct wlr_output *wlr_output,
+    struct wlr_renderer *renderer,
+    pixman_box32_t *rect);
+
 void
 hikari_renderer_normal_mode(struct hikari_renderer *renderer);
 
+void
+hikari_renderer_find_mode(struct hikari_renderer *renderer);
+
 void
 hikari_renderer_group_assign_mode(struct hikari_renderer *renderer);
 
@@ -54,4 +64,7 @@ hikari_renderer_dnd_mode(struct hikari_renderer *renderer);
 void
 hikari_renderer_layout_select_mode(struct hikari_renderer *renderer);
 
+void
+hikari_renderer_overview_mode(struct hikari_renderer *renderer);
+
 #endif
@@ -12,7 +12,9 @@
 #include <hikari/configuration.h>
 #include <hikari/cursor.h>
 #include <hikari/dnd_mode.h>
+#include <hikari/find_mode.h>
 #include <hikari/group_assign_mode.h>
+#include <hikari/group_trie.h>
 #include <hikari/indicator.h>
 #include <hikari/input_grab_mode.h>
 #include <hikari/layout_select_mode.h>
@@ -21,30 +23,64 @@
 #include <hikari/mark_select_mode.h>
 #include <hikari/move_mode.h>
 #include <hikari/normal_mode.h>
+#include <hikari/overview_mode.h>
 #include <hikari/resize_mode.h>
 #include <hikari/sheet_assign_mode.h>
+#include <hikari/view_index.h>
+#include <hikari/view_table.h>
 #include <hikari/workspace.h>
 
 #ifdef HAVE_LAYERSHELL
 #include <hikari/layer_shell.h>
 #endif
 
+#ifdef HAVE_INOTIFY
+#include <hikari/config_watch.h>
+#endif
+
+#ifdef HAVE_IDLE
+#include <hikari/idle.h>
+#endif
+
+#ifdef HAVE_IPC
+#include <hikari/ipc.h>
+#endif
+
+#ifdef HAVE_RECORD
+#include <hikari/recorder.h>
+#endif
+
 struct wlr_input_device;
 
 struct hikari_output;
 struct hikari_group;
+struct hikari_view;
 
 struct hikari_server {
   bool cycling;
-#ifndef NDEBUG
   bool track_damage;
-#endif
 
   const char *socket;
   char *config_path;
 
   struct wl_event_source *shutdown_timer;
 
+#ifdef HAVE_INOTIFY
+  struct hikari_config_watch config_watch;
+#endif
+
+#ifdef HAVE_IDLE
+  struct hikari_idle idle;
+#endif
+
+#ifdef HAVE_IPC
+  struct hikari_ipc ipc;
+#endif
+
+#ifdef HAVE_RECORD
+  struct hikari_recorder recorder;
+#endif
+
   struct hikari_indicator indicator;
 
   struct wl_display *display;
@@ -107,11 +143,18 @@ struct hikari_server {
   struct wl_list outputs;
 
   struct wl_list groups;
+  struct hikari_group_trie group_trie;
   struct wl_list visible_groups;
   struct wl_list visible_views;
+  struct wl_list placements;
+  struct wl_list animations;
+
+  struct hikari_view_index view_index;
+  struct hikari_view_table view_table;
 
   struct hikari_mode *mode;
 
+  struct hikari_find_mode find_mode;
   struct hikari_group_assign_mode group_assign_mode;
   struct hikari_input_grab_mode input_grab_mode;
   struct hikari_layout_select_mode layout_select_mode;
@@ -120,6 +163,7 @@ struct hikari_server {
   struct hikari_mark_select_mode mark_select_mode;
   struct hikari_move_mode move_mode;
   struct hikari_normal_mode normal_mode;
+  struct hikari_overview_mode overview_mode;
   struct hikari_resize_mode resize_mode;
   struct hikari_sheet_assign_mode sheet_assign_mode;
   struct hikari_dnd_mode dnd_mode;
@@ -158,6 +202,9 @@ hikari_server_unset_cycling(void)
   hikari_server.cycling = false;
 }
 
+void
+hikari_server_switch_to_view(struct hikari_view *view);
+
 void
 hikari_server_migrate_focus_view(
     struct hikari_output *output, double lx, double ly, bool center);
@@ -395,6 +442,7 @@ hikari_server_clear_workspace(void *arg)
            (struct hikari_mode *)&hikari_server.name##_mode;                   \
   }
 
+MODE(find)
 MODE(group_assign)
 MODE(input_grab)
 MODE(layout_select)
@@ -403,6 +451,7 @@ MODE(mark_assign)
 MODE(mark_select)
 MODE(move)
 MODE(normal)
+MODE(overview)
 MODE(resize)
 MODE(sheet_assign)
 
@@ -431,9 +480,7 @@ hikari_server_show_mark(void *arg);
 void
 hikari_server_switch_to_mark(void *arg);
 
-#ifndef NDEBUG
 void
 hikari_server_toggle_damage_tracking(void *arg);
-#endif
 
 #endif
@@ -7,6 +7,7 @@
 
 struct hikari_group;
 struct hikari_layout;
+struct hikari_layout_generator;
 struct hikari_split;
 struct hikari_workspace;
 
@@ -81,6 +82,14 @@ hikari_sheet_empty_layout(struct hikari_sheet *sheet,
     int max,
     bool *center);
 
+struct hikari_view *
+hikari_sheet_generated_layout(struct hikari_sheet *sheet,
+    struct hikari_layout_generator *generator,
+    struct hikari_view *first,
+    struct wlr_box *frame,
+    int max,
+    bool *center);
+
 int
 hikari_sheet_tileable_views(struct hikari_sheet *sheet);
 
@@ -100,6 +109,9 @@ void
 hikari_sheet_apply_split(
     struct hikari_sheet *sheet, struct hikari_split *split);
 
+void
+hikari_sheet_retile(struct hikari_sheet *sheet, struct hikari_split *split);
+
 bool
 hikari_sheet_is_visible(struct hikari_sheet *sheet);
 
@@ -0,0 +1,64 @@
+#if !defined(HIKARI_SLAB_H)
+#define HIKARI_SLAB_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <wayland-util.h>
+
+#define HIKARI_SLAB_CHUNK_SIZE 16384
+
+struct hikari_slab {
+  const char *name;
+  size_t size;
+
+  bool initialized;
+  struct wl_list partial_chunks;
+  struct wl_list full_chunks;
+  struct hikari_slab_chunk *spare;
+
+  size_t nr_of_chunks;
+  size_t nr_of_objects;
+  size_t peak;
+
+  struct hikari_slab *next;
+};
+
+#define HIKARI_SLAB(slab_name, object_size)                                    \
+  {                                                                            \
+    .name = slab_name, .size = object_size, .initialized = false               \
+  }
+
+extern struct hikari_slab hikari_animation_slab;
+extern struct hikari_slab hikari_xdg_view_slab;
+extern struct hikari_slab hikari_xdg_popup_slab;
+extern struct hikari_slab hikari_view_subsurface_slab;
+extern struct hikari_slab hikari_tile_slab;
+extern struct hikari_slab hikari_maximized_state_slab;
+extern struct hikari_slab hikari_group_trie_node_slab;
+
+#ifdef HAVE_XWAYLAND
+extern struct hikari_slab hikari_xwayland_view_slab;
+extern struct hikari_slab hikari_xwayland_unmanaged_view_slab;
+#endif
+
+#ifdef HAVE_LAYERSHELL
+extern struct hikari_slab hikari_layer_popup_slab;
+#endif
+
+void *
+hikari_slab_alloc(struct hikari_slab *slab);
+
+void
+hikari_slab_free(struct hikari_slab *slab, void *ptr);
+
+void
+hikari_slab_for_each(void (*func)(struct hikari_slab *, void *), void *data);
+
+char *
+hikari_string_dup(const char *str);
+
+void
+hikari_string_free(char *str);
+
+#endif
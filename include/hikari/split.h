@@ -3,6 +3,7 @@
 
 #include <wlr/util/box.h>
 
+struct hikari_layout_generator;
 struct hikari_renderer;
 struct hikari_sheet;
 struct hikari_view;
@@ -81,6 +82,7 @@ struct hikari_split_container {
   int max;
 
   hikari_layout_func layout;
+  struct hikari_layout_generator *generator;
 };
 
 void
@@ -99,6 +101,10 @@ hikari_split_free(struct hikari_split *split);
 struct hikari_split *
 hikari_split_copy(struct hikari_split *split);
 
+bool
+hikari_split_uses_generator(
+    struct hikari_split *split, struct hikari_layout_generator *generator);
+
 void
 hikari_split_vertical_init(struct hikari_split_vertical *split_vertical,
     struct hikari_split_scale *scale,
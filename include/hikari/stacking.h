@@ -0,0 +1,50 @@
+#if !defined(HIKARI_STACKING_H)
+#define HIKARI_STACKING_H
+
+#include <stdbool.h>
+
+#include <pixman.h>
+#include <wayland-util.h>
+
+#include <wlr/util/box.h>
+
+struct hikari_view;
+
+// A snapshot of the views of a workspace in stacking order along with the
+// bounds of their border and root surface. It is only rebuilt after
+// hikari_stacking_invalidate, which therefore has to be called whenever
+// stacking order, visibility, geometry, the committed size of a root surface
+// or the presence of child surfaces changes. Debug builds compare the
+// snapshot against the workspace on every update and warn about changes
+// that missed an invalidation.
+struct hikari_stacking {
+  struct hikari_view **views;
+  struct wlr_box *bounds;
+  bool *nested;
+
+  int nr_of_views;
+  int capacity;
+  unsigned long generation;
+};
+
+void
+hikari_stacking_init(struct hikari_stacking *stacking);
+
+void
+hikari_stacking_fini(struct hikari_stacking *stacking);
+
+void
+hikari_stacking_invalidate(void);
+
+void
+hikari_stacking_update(struct hikari_stacking *stacking, struct wl_list *views);
+
+bool
+hikari_stacking_may_contain(
+    struct hikari_stacking *stacking, int i, double ox, double oy);
+
+bool
+hikari_stacking_may_intersect(
+    struct hikari_stacking *stacking, int i, pixman_region32_t *region);
+
+#endif
@@ -0,0 +1,49 @@
+#if !defined(HIKARI_SURFACE_CACHE_H)
+#define HIKARI_SURFACE_CACHE_H
+
+#include <stdbool.h>
+
+#include <wlr/util/box.h>
+
+struct hikari_node;
+struct wlr_surface;
+
+struct hikari_surface_cache_entry {
+  struct wlr_surface *surface;
+  struct wlr_box box;
+};
+
+struct hikari_surface_cache {
+  struct hikari_surface_cache_entry *entries;
+  int nr_of_entries;
+  int capacity;
+  bool dirty;
+};
+
+void
+hikari_surface_cache_init(struct hikari_surface_cache *surface_cache);
+
+void
+hikari_surface_cache_fini(struct hikari_surface_cache *surface_cache);
+
+void
+hikari_surface_cache_commit(struct hikari_surface_cache *surface_cache,
+    struct wlr_surface *surface,
+    int sx,
+    int sy);
+
+struct wlr_surface *
+hikari_surface_cache_surface_at(struct hikari_surface_cache *surface_cache,
+    struct hikari_node *node,
+    double x,
+    double y,
+    double *sx,
+    double *sy);
+
+static inline void
+hikari_surface_cache_invalidate(struct hikari_surface_cache *surface_cache)
+{
+  surface_cache->dirty = true;
+}
+
+#endif
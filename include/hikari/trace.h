@@ -0,0 +1,50 @@
+#if !defined(HIKARI_TRACE_H)
+#define HIKARI_TRACE_H
+
+#ifdef HAVE_TRACE
+#include <stdint.h>
+
+#include <wayland-server-core.h>
+
+#define HIKARI_TRACE_RING_SIZE 65536
+
+struct hikari_trace_event {
+  const char *name;
+  uint64_t timestamp;
+  char phase;
+};
+
+struct hikari_trace_scope {
+  const char *name;
+};
+
+void
+hikari_trace_init(struct wl_event_loop *event_loop);
+
+void
+hikari_trace_fini(void);
+
+void
+hikari_trace_begin(const char *name);
+
+void
+hikari_trace_end(const char *name);
+
+const char *
+hikari_trace_dump(void);
+
+static inline void
+hikari_trace_scope_end(struct hikari_trace_scope *scope)
+{
+  hikari_trace_end(scope->name);
+}
+
+#define HIKARI_TRACE_SCOPE(scope_name)                                         \
+  struct hikari_trace_scope hikari_trace_scope                                 \
+      __attribute__((cleanup(hikari_trace_scope_end))) = { scope_name };       \
+  hikari_trace_begin(scope_name)
+#else
+#define HIKARI_TRACE_SCOPE(scope_name)
+#endif
+
+#endif
@@ -17,11 +17,15 @@
 #include <hikari/output.h>
 #include <hikari/server.h>
 #include <hikari/sheet.h>
+#include <hikari/surface_cache.h>
 #include <hikari/tile.h>
 #include <hikari/workspace.h>
 
+struct hikari_animation;
 struct hikari_mark;
 struct hikari_renderer;
+struct hikari_view_index_entry;
+struct hikari_view_placement;
 
 struct hikari_view;
 
@@ -47,9 +51,14 @@ struct hikari_view {
   struct hikari_border border;
   struct hikari_indicator_frame indicator_frame;
   struct hikari_tile *tile;
+  struct hikari_view_placement *placement;
+  struct hikari_view_index_entry *index_entry;
+  struct hikari_animation *animation;
+  uint32_t serial;
 
   struct wlr_box geometry;
   struct hikari_maximized_state *maximized_state;
+  struct hikari_surface_cache surface_cache;
 
   struct wl_list output_views;
   struct wl_list workspace_views;
@@ -84,6 +93,9 @@ struct hikari_view_child {
   struct wlr_surface *surface;
   struct hikari_view *parent;
 
+  int sx;
+  int sy;
+
   struct wl_listener commit;
   struct wl_listener new_subsurface;
 };
@@ -180,7 +192,18 @@ hikari_view_commit_pending_operation(
     struct hikari_view *view, struct wlr_box *geometry);
 
 void
-hikari_view_evacuate(struct hikari_view *view, struct hikari_sheet *sheet);
+hikari_view_commit_surface(struct hikari_view *view);
+
+void
+hikari_view_evacuate(
+    struct hikari_view *view, struct hikari_sheet *sheet, bool retile);
+
+void
+hikari_view_settle(struct hikari_view *view);
+
+void
+hikari_view_restore_geometry(
+    struct hikari_view *view, struct wlr_box *geometry);
 
 void
 hikari_view_pin_to_sheet(struct hikari_view *view, struct hikari_sheet *sheet);
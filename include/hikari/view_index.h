@@ -0,0 +1,60 @@
+#if !defined(HIKARI_VIEW_INDEX_H)
+#define HIKARI_VIEW_INDEX_H
+
+#include <stdint.h>
+
+#include <wayland-util.h>
+
+#define HIKARI_VIEW_INDEX_TEXT_SIZE 256
+#define HIKARI_VIEW_INDEX_BUCKETS 4096
+
+struct hikari_view;
+
+struct hikari_view_index_entry {
+  struct hikari_view *view;
+  char text[HIKARI_VIEW_INDEX_TEXT_SIZE];
+
+  uint32_t *grams;
+  int nr_of_grams;
+
+  struct wl_list index_entries;
+};
+
+struct hikari_view_index_postings {
+  uint32_t gram;
+
+  struct hikari_view_index_entry **entries;
+  int nr_of_entries;
+  int capacity;
+
+  struct hikari_view_index_postings *next;
+};
+
+struct hikari_view_index {
+  struct hikari_view_index_postings *buckets[HIKARI_VIEW_INDEX_BUCKETS];
+  struct wl_list entries;
+
+  unsigned long generation;
+};
+
+void
+hikari_view_index_init(struct hikari_view_index *index);
+
+void
+hikari_view_index_fini(struct hikari_view_index *index);
+
+void
+hikari_view_index_update(
+    struct hikari_view_index *index, struct hikari_view *view);
+
+void
+hikari_view_index_remove(
+    struct hikari_view_index *index, struct hikari_view *view);
+
+int
+hikari_view_index_search(struct hikari_view_index *index,
+    const char *query,
+    struct hikari_view **results,
+    int max);
+
+#endif
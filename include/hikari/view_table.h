@@ -0,0 +1,37 @@
+#if !defined(HIKARI_VIEW_TABLE_H)
+#define HIKARI_VIEW_TABLE_H
+
+#include <stdint.h>
+
+struct hikari_view;
+
+struct hikari_view_table_entry {
+  uint32_t serial;
+  struct hikari_view *view;
+};
+
+struct hikari_view_table {
+  struct hikari_view_table_entry *entries;
+  int nr_of_entries;
+  int capacity;
+
+  uint32_t next_serial;
+};
+
+void
+hikari_view_table_init(struct hikari_view_table *view_table);
+
+void
+hikari_view_table_fini(struct hikari_view_table *view_table);
+
+uint32_t
+hikari_view_table_insert(
+    struct hikari_view_table *view_table, struct hikari_view *view);
+
+void
+hikari_view_table_remove(struct hikari_view_table *view_table, uint32_t serial);
+
+struct hikari_view *
+hikari_view_table_lookup(struct hikari_view_table *view_table, uint32_t serial);
+
+#endif
@@ -4,6 +4,8 @@
 #include <wayland-server-core.h>
 #include <wayland-util.h>
 
+#include <hikari/stacking.h>
+
 #ifdef HAVE_LAYERSHELL
 struct hikari_layer;
 #endif
@@ -27,6 +29,7 @@ struct hikari_workspace {
 #endif
 
   struct wl_list views;
+  struct hikari_stacking stacking;
 };
 
 void
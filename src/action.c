@@ -20,20 +20,11 @@ lookup_action(struct wl_list *action_configs, const char *action_name)
 }
 
 static bool
-parse_binding(struct wl_list *action_configs,
-    const ucl_object_t *obj,
+resolve_action(struct wl_list *action_configs,
+    const char *str,
     void (**action)(void *),
     void **arg)
 {
-  const char *str;
-  bool success = false;
-
-  if (!ucl_object_tostring_safe(obj, &str)) {
-    fprintf(
-        stderr, "configuration error: expected string for binding action\n");
-    goto done;
-  }
-
   if (!strcmp(str, "quit")) {
     *action = hikari_server_terminate;
     *arg = NULL;
@@ -43,11 +34,9 @@ parse_binding(struct wl_list *action_configs,
   } else if (!strcmp(str, "reload")) {
     *action = hikari_server_reload;
     *arg = NULL;
-#ifndef NDEBUG
   } else if (!strcmp(str, "debug-damage")) {
     *action = hikari_server_toggle_damage_tracking;
     *arg = NULL;
-#endif
 
 #define PARSE_MOVE_BINDING(d, f)                                               \
   }                                                                            \
@@ -265,6 +254,9 @@ parse_binding(struct wl_list *action_configs,
     *action = hikari_server_layout_restack_prepend;
     *arg = NULL;
 
+  } else if (!strcmp(str, "mode-enter-find")) {
+    *action = hikari_server_enter_find_mode;
+    *arg = NULL;
   } else if (!strcmp(str, "mode-enter-group-assign")) {
     *action = hikari_server_enter_group_assign_mode;
     *arg = NULL;
@@ -283,6 +275,9 @@ parse_binding(struct wl_list *action_configs,
   } else if (!strcmp(str, "mode-enter-move")) {
     *action = hikari_server_enter_move_mode;
     *arg = NULL;
+  } else if (!strcmp(str, "mode-enter-overview")) {
+    *action = hikari_server_enter_overview_mode;
+    *arg = NULL;
   } else if (!strcmp(str, "mode-enter-resize")) {
     *action = hikari_server_enter_resize_mode;
     *arg = NULL;
@@ -427,23 +422,39 @@ parse_binding(struct wl_list *action_configs,
     PARSE_VT_BINDING(9)
 #undef PARSE_VT_BINDING
 
-  } else {
-    if (!strncmp(str, "action-", 7)) {
-      char *command = NULL;
-      const char *action_name = &str[7];
-      if ((command = lookup_action(action_configs, action_name)) == NULL) {
-        fprintf(stderr,
-            "configuration error: unknown action \"%s\"\n",
-            action_name);
-        goto done;
-      } else {
-        *action = hikari_server_execute_command;
-        *arg = command;
-      }
-    } else {
-      fprintf(stderr, "configuration error: unknown action \"%s\"\n", str);
-      goto done;
+  } else if (!strncmp(str, "action-", 7)) {
+    char *command = lookup_action(action_configs, &str[7]);
+    if (command == NULL) {
+      return false;
     }
+
+    *action = hikari_server_execute_command;
+    *arg = command;
+  } else {
+    return false;
+  }
+
+  return true;
+}
+
+static bool
+parse_binding(struct wl_list *action_configs,
+    const ucl_object_t *obj,
+    void (**action)(void *),
+    void **arg)
+{
+  const char *str;
+  bool success = false;
+
+  if (!ucl_object_tostring_safe(obj, &str)) {
+    fprintf(
+        stderr, "configuration error: expected string for binding action\n");
+    goto done;
+  }
+
+  if (!resolve_action(action_configs, str, action, arg)) {
+    fprintf(stderr, "configuration error: unknown action \"%s\"\n", str);
+    goto done;
   }
 
   success = true;
@@ -452,6 +463,17 @@ done:
   return success;
 }
 
+bool
+hikari_action_resolve(struct hikari_event_action *event_action,
+    struct wl_list *action_configs,
+    const char *action_name)
+{
+  return resolve_action(action_configs,
+      action_name,
+      &event_action->action,
+      &event_action->arg);
+}
+
 void
 hikari_action_init(struct hikari_action *action)
 {
@@ -0,0 +1,149 @@
+#include <hikari/animation.h>
+
+#include <hikari/configuration.h>
+#include <hikari/output.h>
+#include <hikari/server.h>
+#include <hikari/slab.h>
+#include <hikari/view.h>
+
+static void
+bounding_box(struct wlr_box *dst, struct wlr_box *a, struct wlr_box *b)
+{
+  int x1 = a->x < b->x ? a->x : b->x;
+  int y1 = a->y < b->y ? a->y : b->y;
+  int x2 = a->x + a->width > b->x + b->width ? a->x + a->width
+                                             : b->x + b->width;
+  int y2 = a->y + a->height > b->y + b->height ? a->y + a->height
+                                               : b->y + b->height;
+
+  dst->x = x1;
+  dst->y = y1;
+  dst->width = x2 - x1;
+  dst->height = y2 - y1;
+}
+
+static inline int
+lerp(int from, int to, double t)
+{
+  return from + (to - from) * t;
+}
+
+static int
+elapsed_msec(struct hikari_animation *animation, const struct timespec *now)
+{
+  return (now->tv_sec - animation->start.tv_sec) * 1000 +
+         (now->tv_nsec - animation->start.tv_nsec) / 1000000L;
+}
+
+static void
+destroy(struct hikari_animation *animation)
+{
+  animation->view->animation = NULL;
+
+  wl_list_remove(&animation->server_animations);
+  hikari_slab_free(&hikari_animation_slab, animation);
+}
+
+void
+hikari_animation_start(struct hikari_view *view, struct wlr_box *from)
+{
+  int duration = hikari_configuration->animation_duration;
+
+  if (duration == 0 || hikari_view_is_hidden(view) ||
+      hikari_server_in_move_mode() || hikari_server_in_resize_mode()) {
+    return;
+  }
+
+  struct hikari_animation *animation = view->animation;
+  struct wlr_box *to = hikari_view_geometry(view);
+
+  if (animation == NULL) {
+    if (from->x == to->x && from->y == to->y && from->width == to->width &&
+        from->height == to->height) {
+      return;
+    }
+
+    animation = hikari_slab_alloc(&hikari_animation_slab);
+    animation->view = view;
+    wl_list_insert(
+        &hikari_server.animations, &animation->server_animations);
+    view->animation = animation;
+  } else {
+    // retarget from wherever the running animation currently is
+    from = &animation->box;
+    hikari_output_add_damage(animation->output, &animation->damage);
+  }
+
+  animation->output = view->output;
+  animation->duration = duration;
+  animation->from = *from;
+  animation->box = *from;
+  clock_gettime(CLOCK_MONOTONIC, &animation->start);
+
+  bounding_box(&animation->damage, from, to);
+  hikari_output_add_damage(animation->output, &animation->damage);
+}
+
+void
+hikari_animation_cancel(struct hikari_view *view)
+{
+  struct hikari_animation *animation = view->animation;
+
+  if (animation != NULL) {
+    hikari_output_add_damage(animation->output, &animation->damage);
+    destroy(animation);
+  }
+}
+
+void
+hikari_animations_frame(
+    struct hikari_output *output, const struct timespec *now)
+{
+  struct hikari_animation *animation, *animation_temp;
+  wl_list_for_each_safe (animation,
+      animation_temp,
+      &hikari_server.animations,
+      server_animations) {
+    if (animation->output != output) {
+      continue;
+    }
+
+    struct hikari_view *view = animation->view;
+    struct wlr_box *from = &animation->from;
+    struct wlr_box *to = hikari_view_geometry(view);
+    int elapsed = elapsed_msec(animation, now);
+
+    hikari_output_add_damage(output, &animation->damage);
+
+    if (elapsed >= animation->duration) {
+      destroy(animation);
+      hikari_view_damage_whole(view);
+      continue;
+    }
+
+    double t = (double)elapsed / animation->duration;
+    double eased = 1 - (1 - t) * (1 - t) * (1 - t);
+
+    animation->box.x = lerp(from->x, to->x, eased);
+    animation->box.y = lerp(from->y, to->y, eased);
+    animation->box.width = lerp(from->width, to->width, eased);
+    animation->box.height = lerp(from->height, to->height, eased);
+
+    bounding_box(&animation->damage, from, to);
+    hikari_output_add_damage(output, &animation->damage);
+  }
+}
+
+void
+hikari_animations_cancel(struct hikari_output *output)
+{
+  struct hikari_animation *animation, *animation_temp;
+  wl_list_for_each_safe (animation,
+      animation_temp,
+      &hikari_server.animations,
+      server_animations) {
+    if (animation->output == output) {
+      destroy(animation);
+    }
+  }
+}
@@ -4,78 +4,66 @@
 #include <stdlib.h>
 #include <string.h>
 
-#include <hikari/memory.h>
+#include <hikari/group.h>
+#include <hikari/group_trie.h>
 
 void
-hikari_completion_init(struct hikari_completion *completion, char *data)
+hikari_completion_init(struct hikari_completion *completion,
+    struct hikari_group_trie *trie,
+    char *input)
 {
-  struct hikari_completion_item *item;
-  wl_list_init(&completion->items);
-  hikari_completion_add(completion, data);
-  item = wl_container_of(completion->items.next, item, completion_items);
-  completion->current_item = item;
-}
-
-void
-hikari_completion_fini(struct hikari_completion *completion)
-{
-  assert(completion != NULL);
+  strncpy(completion->input, input, sizeof(completion->input) - 1);
+  completion->input[sizeof(completion->input) - 1] = '\0';
 
-  struct hikari_completion_item *item = NULL, *item_temp;
-
-  wl_list_for_each_safe (
-      item, item_temp, &completion->items, completion_items) {
-    wl_list_remove(&item->completion_items);
-    hikari_free(item);
-  }
+  completion->trie = trie;
+  completion->prefix = hikari_group_trie_lookup(trie, input);
+  completion->current = NULL;
+  completion->generation = trie->generation;
 }
 
-void
-hikari_completion_add(struct hikari_completion *completion, char *data)
+char *
+hikari_completion_cancel(struct hikari_completion *completion)
 {
   assert(completion != NULL);
 
-  struct hikari_completion_item *completion_item =
-      hikari_malloc(sizeof(struct hikari_completion_item));
+  completion->current = NULL;
 
-  strncpy(completion_item->data, data, sizeof(completion_item->data) - 1);
-
-  wl_list_insert(completion->items.prev, &completion_item->completion_items);
+  return completion->input;
 }
 
-char *
-hikari_completion_cancel(struct hikari_completion *completion)
+static void
+revalidate(struct hikari_completion *completion)
 {
-  assert(completion != NULL);
-  assert(!wl_list_empty(&completion->items));
-
-  struct hikari_completion_item *item =
-      wl_container_of(completion->items.next, item, completion_items);
+  struct hikari_group_trie *trie = completion->trie;
 
-  completion->current_item = item;
-
-  return item->data;
+  if (completion->generation != trie->generation) {
+    completion->prefix = hikari_group_trie_lookup(trie, completion->input);
+    completion->current = NULL;
+    completion->generation = trie->generation;
+  }
 }
 
 #define COMPLETION(link)                                                       \
   char *hikari_completion_##link(struct hikari_completion *completion)         \
   {                                                                            \
     assert(completion != NULL);                                                \
-    assert(!wl_list_empty(&completion->items));                                \
                                                                                \
-    struct wl_list *link;                                                      \
-    struct hikari_completion_item *item;                                       \
+    revalidate(completion);                                                    \
                                                                                \
-    link = completion->current_item->completion_items.link;                    \
-    if (link == &completion->items) {                                          \
-      item = wl_container_of(completion->items.link, item, completion_items);  \
-    } else {                                                                   \
-      item = wl_container_of(link, item, completion_items);                    \
+    struct hikari_group_trie_node *prefix = completion->prefix;                \
+    struct hikari_group_trie_node *node = completion->current;                 \
+                                                                               \
+    if (prefix == NULL) {                                                      \
+      return completion->input;                                                \
     }                                                                          \
                                                                                \
-    completion->current_item = item;                                           \
+    do {                                                                       \
+      node = hikari_group_trie_##link(node, prefix);                           \
+    } while (node != NULL && (node == prefix || node->group == NULL));         \
+                                                                               \
+    completion->current = node;                                                \
                                                                                \
-    return item->data;                                                         \
+    return node != NULL ? node->group->name : completion->input;               \
   }
 
 COMPLETION(next)
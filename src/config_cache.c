@@ -0,0 +1,573 @@
+#include <hikari/config_cache.h>
+
+#include <ctype.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <hikari/memory.h>
+
+static const char hikari_config_cache_magic[8] = "HKRCFG02";
+
+struct hikari_config_cache_scan {
+  bool macros;
+
+  char *names;
+  size_t names_size;
+  size_t names_capacity;
+};
+
+static uint64_t
+hash_bytes(uint64_t hash, const void *data, size_t size)
+{
+  const unsigned char *bytes = data;
+
+  for (size_t i = 0; i < size; i++) {
+    hash ^= bytes[i];
+    hash *= 0x100000001b3ULL;
+  }
+
+  return hash;
+}
+
+static const uint64_t hash_init = 0xcbf29ce484222325ULL;
+
+static uint64_t
+hash_environment(const char *names, size_t names_size)
+{
+  uint64_t hash = hash_init;
+
+  for (size_t offset = 0; offset < names_size;
+       offset += strlen(names + offset) + 1) {
+    const char *name = names + offset;
+    const char *value = getenv(name);
+    unsigned char set = value != NULL;
+
+    hash = hash_bytes(hash, name, strlen(name) + 1);
+    hash = hash_bytes(hash, &set, 1);
+
+    if (value != NULL) {
+      hash = hash_bytes(hash, value, strlen(value) + 1);
+    }
+  }
+
+  return hash;
+}
+
+char *
+hikari_config_cache_file(const char *name)
+{
+  char *prefix = getenv("XDG_CACHE_HOME");
+  char *subdirectory;
+
+  if (prefix == NULL) {
+    prefix = getenv("HOME");
+    subdirectory = "/.cache/hikari/";
+  } else {
+    subdirectory = "/hikari/";
+  }
+
+  if (prefix == NULL) {
+    return NULL;
+  }
+
+  size_t len = strlen(prefix) + strlen(subdirectory) + strlen(name);
+  char *ret = hikari_malloc(len + 1);
+
+  strcpy(ret, prefix);
+  strcat(ret, subdirectory);
+  strcat(ret, name);
+
+  return ret;
+}
+
+uint64_t
+hikari_config_cache_hash(const void *data, size_t size)
+{
+  return hash_bytes(hash_init, data, size);
+}
+
+static char *
+cache_path(const char *config_path)
+{
+  uint64_t hash = hash_bytes(hash_init, config_path, strlen(config_path));
+  char name[32];
+  snprintf(name, sizeof(name), "config-%016llx", (unsigned long long)hash);
+
+  return hikari_config_cache_file(name);
+}
+
+static inline bool
+is_name_char(char c)
+{
+  return isalnum((unsigned char)c) || c == '_';
+}
+
+static void
+add_name(struct hikari_config_cache_scan *scan, const char *name, size_t len)
+{
+  for (size_t offset = 0; offset < scan->names_size;
+       offset += strlen(scan->names + offset) + 1) {
+    const char *known = scan->names + offset;
+
+    if (strlen(known) == len && !strncmp(known, name, len)) {
+      return;
+    }
+  }
+
+  if (scan->names_size + len + 1 > scan->names_capacity) {
+    scan->names_capacity = (scan->names_size + len + 1) * 2;
+
+    char *names = hikari_malloc(scan->names_capacity);
+    if (scan->names_size > 0) {
+      memcpy(names, scan->names, scan->names_size);
+    }
+    hikari_free(scan->names);
+    scan->names = names;
+  }
+
+  memcpy(scan->names + scan->names_size, name, len);
+  scan->names[scan->names_size + len] = '\0';
+  scan->names_size += len + 1;
+}
+
+static const char *
+scan_variable(struct hikari_config_cache_scan *scan, const char *p)
+{
+  const char *start = p + 1;
+  bool braced = *start == '{';
+
+  if (braced) {
+    start++;
+  }
+
+  const char *end = start;
+  while (is_name_char(*end)) {
+    end++;
+  }
+
+  if (end > start && (!braced || *end == '}')) {
+    add_name(scan, start, end - start);
+  }
+
+  return end > start ? end : p + 1;
+}
+
+static const char *
+scan_heredoc(struct hikari_config_cache_scan *scan, const char *p)
+{
+  const char *tag = p + 2;
+  const char *tag_end = tag;
+
+  while (isupper((unsigned char)*tag_end)) {
+    tag_end++;
+  }
+
+  size_t tag_len = tag_end - tag;
+  if (tag_len == 0 || *tag_end != '\n') {
+    return p + 2;
+  }
+
+  p = tag_end + 1;
+  while (*p != '\0') {
+    if (!strncmp(p, tag, tag_len) &&
+        (p[tag_len] == '\n' || p[tag_len] == '\0')) {
+      return p + tag_len;
+    }
+
+    while (*p != '\0' && *p != '\n') {
+      p = *p == '$' ? scan_variable(scan, p) : p + 1;
+    }
+
+    if (*p == '\n') {
+      p++;
+    }
+  }
+
+  return p;
+}
+
+// Walks the UCL source skipping comments and single quoted strings to
+// collect the variables it references and to detect macros such as
+// ".include" which pull in files that are not part of the cache key.
+static void
+scan_source(struct hikari_config_cache_scan *scan, const char *p)
+{
+  bool statement = true;
+
+  while (*p != '\0') {
+    char c = *p;
+
+    if (c == '#' || (c == '/' && p[1] == '/')) {
+      p = strchr(p, '\n');
+      if (p == NULL) {
+        return;
+      }
+    } else if (c == '/' && p[1] == '*') {
+      int depth = 1;
+
+      for (p += 2; *p != '\0' && depth > 0; p++) {
+        if (p[0] == '/' && p[1] == '*') {
+          depth++;
+          p++;
+        } else if (p[0] == '*' && p[1] == '/') {
+          depth--;
+          p++;
+        }
+      }
+    } else if (c == '\'') {
+      for (p++; *p != '\0' && *p != '\''; p++) {
+        if (*p == '\\' && p[1] != '\0') {
+          p++;
+        }
+      }
+      if (*p != '\0') {
+        p++;
+      }
+      statement = false;
+    } else if (c == '"') {
+      p++;
+      while (*p != '\0' && *p != '"') {
+        if (*p == '\\' && p[1] != '\0') {
+          p += 2;
+        } else if (*p == '$') {
+          p = scan_variable(scan, p);
+        } else {
+          p++;
+        }
+      }
+      if (*p != '\0') {
+        p++;
+      }
+      statement = false;
+    } else if (c == '<' && p[1] == '<') {
+      p = scan_heredoc(scan, p);
+      statement = false;
+    } else if (c == '$') {
+      p = scan_variable(scan, p);
+      statement = false;
+    } else if (c == '.' && statement) {
+      scan->macros = true;
+      return;
+    } else {
+      if (c == '\n' || c == '{' || c == '}' || c == '[' || c == ';' ||
+          c == ',') {
+        statement = true;
+      } else if (!isspace((unsigned char)c)) {
+        statement = false;
+      }
+      p++;
+    }
+  }
+}
+
+static char *
+read_source(int fd, size_t size)
+{
+  char *source = hikari_malloc(size + 1);
+  size_t offset = 0;
+
+  while (offset < size) {
+    ssize_t ret = read(fd, source + offset, size - offset);
+
+    if (ret <= 0) {
+      hikari_free(source);
+      return NULL;
+    }
+
+    offset += ret;
+  }
+  source[size] = '\0';
+
+  return source;
+}
+
+static void
+identify(struct hikari_config_cache_header *header, struct stat *st)
+{
+  memset(header, 0, sizeof(struct hikari_config_cache_header));
+  memcpy(header->magic, hikari_config_cache_magic, sizeof(header->magic));
+  header->dev = st->st_dev;
+  header->ino = st->st_ino;
+  header->source_size = st->st_size;
+  header->mtime_sec = st->st_mtim.tv_sec;
+  header->mtime_nsec = st->st_mtim.tv_nsec;
+  header->ctime_sec = st->st_ctim.tv_sec;
+  header->ctime_nsec = st->st_ctim.tv_nsec;
+}
+
+static inline bool
+same_identity(struct hikari_config_cache_header *a,
+    struct hikari_config_cache_header *b)
+{
+  return !memcmp(a, b, offsetof(struct hikari_config_cache_header, env_hash));
+}
+
+void
+hikari_config_cache_init(
+    struct hikari_config_cache *cache, const char *config_path)
+{
+  cache->path = cache_path(config_path);
+  cache->config_path = hikari_malloc(strlen(config_path) + 1);
+  cache->cacheable = false;
+  cache->data = NULL;
+  cache->size = 0;
+
+  strcpy(cache->config_path, config_path);
+
+  // the source is only read when a new cache file has to be written, a
+  // valid cache is recognized by the identity of the configuration file
+  struct stat st;
+  if (cache->path == NULL || stat(config_path, &st) == -1) {
+    return;
+  }
+
+  identify(&cache->header, &st);
+
+  cache->cacheable = true;
+}
+
+void
+hikari_config_cache_fini(struct hikari_config_cache *cache)
+{
+  if (cache->data != NULL) {
+    munmap(cache->data, cache->size);
+  }
+
+  hikari_free(cache->config_path);
+  hikari_free(cache->path);
+}
+
+ucl_object_t *
+hikari_config_cache_load(struct hikari_config_cache *cache, uint64_t *sections)
+{
+  if (!cache->cacheable) {
+    return NULL;
+  }
+
+  int fd = open(cache->path, O_RDONLY | O_CLOEXEC);
+  if (fd == -1) {
+    return NULL;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) == -1 ||
+      st.st_size <= (off_t)sizeof(struct hikari_config_cache_header)) {
+    close(fd);
+    return NULL;
+  }
+
+  void *data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+
+  if (data == MAP_FAILED) {
+    return NULL;
+  }
+
+  struct hikari_config_cache_header *header = data;
+  const char *names = (const char *)(header + 1);
+  size_t size = st.st_size - sizeof(struct hikari_config_cache_header);
+
+  if (!same_identity(header, &cache->header) ||
+      header->names_size > size ||
+      header->payload_size != size - header->names_size ||
+      (header->names_size > 0 && names[header->names_size - 1] != '\0') ||
+      header->env_hash != hash_environment(names, header->names_size)) {
+    munmap(data, st.st_size);
+    return NULL;
+  }
+
+  struct ucl_parser *parser = ucl_parser_new(UCL_PARSER_ZEROCOPY);
+  ucl_object_t *configuration_obj = NULL;
+
+  if (ucl_parser_add_chunk_full(parser,
+          (const unsigned char *)names + header->names_size,
+          header->payload_size,
+          0,
+          UCL_DUPLICATE_APPEND,
+          UCL_PARSE_MSGPACK)) {
+    configuration_obj = ucl_parser_get_object(parser);
+  }
+  ucl_parser_free(parser);
+
+  if (configuration_obj == NULL) {
+    munmap(data, st.st_size);
+    return NULL;
+  }
+
+  memcpy(sections, header->sections, sizeof(header->sections));
+
+  cache->data = data;
+  cache->size = st.st_size;
+
+  return configuration_obj;
+}
+
+uint64_t
+hikari_config_cache_hash_object(const ucl_object_t *obj)
+{
+  if (obj == NULL) {
+    return 0;
+  }
+
+  unsigned char *emitted = ucl_object_emit(obj, UCL_EMIT_JSON_COMPACT);
+  if (emitted == NULL) {
+    return 0;
+  }
+
+  uint64_t hash = hash_bytes(hash_init, emitted, strlen((char *)emitted));
+  free(emitted);
+
+  return hash;
+}
+
+static void
+create_directories(char *path)
+{
+  for (char *slash = strchr(path + 1, '/'); slash != NULL;
+       slash = strchr(slash + 1, '/')) {
+    *slash = '\0';
+    mkdir(path, 0700);
+    *slash = '/';
+  }
+}
+
+static bool
+write_all(int fd, const struct iovec *iov, int iovcnt)
+{
+  for (int i = 0; i < iovcnt; i++) {
+    const char *bytes = iov[i].iov_base;
+    size_t size = iov[i].iov_len;
+
+    while (size > 0) {
+      ssize_t ret = write(fd, bytes, size);
+
+      if (ret <= 0) {
+        return false;
+      }
+
+      bytes += ret;
+      size -= ret;
+    }
+  }
+
+  return true;
+}
+
+static void
+write_file(const char *path, const struct iovec *iov, int iovcnt)
+{
+  size_t len = strlen(path) + strlen(".XXXXXX");
+  char *tmp_path = hikari_malloc(len + 1);
+  strcpy(tmp_path, path);
+
+  create_directories(tmp_path);
+
+  strcat(tmp_path, ".XXXXXX");
+
+  int fd = mkstemp(tmp_path);
+  if (fd == -1) {
+    goto done;
+  }
+
+  bool success = write_all(fd, iov, iovcnt);
+
+  close(fd);
+
+  if (!success || rename(tmp_path, path) == -1) {
+    unlink(tmp_path);
+  }
+
+done:
+  hikari_free(tmp_path);
+}
+
+void
+hikari_config_cache_write_file(const char *path, const void *data, size_t size)
+{
+  struct iovec iov = { .iov_base = (void *)data, .iov_len = size };
+
+  write_file(path, &iov, 1);
+}
+
+static bool
+scan_config(struct hikari_config_cache *cache,
+    struct hikari_config_cache_scan *scan)
+{
+  int fd = open(cache->config_path, O_RDONLY | O_CLOEXEC);
+  if (fd == -1) {
+    return false;
+  }
+
+  struct stat st;
+  struct hikari_config_cache_header current;
+  char *source;
+  if (fstat(fd, &st) == -1) {
+    close(fd);
+    return false;
+  }
+
+  // the file changed after it was parsed, leave caching to the next load
+  identify(&current, &st);
+  if (!same_identity(&current, &cache->header) ||
+      (source = read_source(fd, st.st_size)) == NULL) {
+    close(fd);
+    return false;
+  }
+  close(fd);
+
+  scan_source(scan, source);
+  hikari_free(source);
+
+  return !scan->macros;
+}
+
+void
+hikari_config_cache_store(struct hikari_config_cache *cache,
+    const ucl_object_t *configuration_obj,
+    const uint64_t *sections)
+{
+  if (!cache->cacheable) {
+    return;
+  }
+
+  struct hikari_config_cache_scan scan = { 0 };
+
+  if (!scan_config(cache, &scan)) {
+    goto done;
+  }
+
+  size_t payload_size;
+  unsigned char *payload =
+      ucl_object_emit_len(configuration_obj, UCL_EMIT_MSGPACK, &payload_size);
+
+  if (payload == NULL) {
+    goto done;
+  }
+
+  struct hikari_config_cache_header *header = &cache->header;
+
+  header->env_hash = hash_environment(scan.names, scan.names_size);
+  memcpy(header->sections, sections, sizeof(header->sections));
+  header->names_size = scan.names_size;
+  header->payload_size = payload_size;
+
+  struct iovec iov[] = {
+    { .iov_base = header,
+        .iov_len = sizeof(struct hikari_config_cache_header) },
+    { .iov_base = scan.names, .iov_len = scan.names_size },
+    { .iov_base = payload, .iov_len = payload_size },
+  };
+
+  write_file(cache->path, iov, sizeof(iov) / sizeof(iov[0]));
+
+  free(payload);
+
+done:
+  hikari_free(scan.names);
+}
@@ -0,0 +1,340 @@
+#include <hikari/config_watch.h>
+
+#include <dirent.h>
+#include <libgen.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <hikari/configuration.h>
+#include <hikari/keyboard_config.h>
+#include <hikari/keymap_cache.h>
+#include <hikari/memory.h>
+#include <hikari/output.h>
+#include <hikari/output_config.h>
+#include <hikari/server.h>
+
+static char *
+copy_path(const char *path)
+{
+  char *ret = hikari_malloc(strlen(path) + 1);
+
+  strcpy(ret, path);
+
+  return ret;
+}
+
+static void
+watch_file(struct hikari_config_watch *watch,
+    const char *path,
+    enum hikari_config_watch_kind kind)
+{
+  char *dir_path = copy_path(path);
+  char *base_path = copy_path(path);
+
+  // watches on a shared directory accumulate their masks
+  int wd = inotify_add_watch(watch->fd,
+      dirname(dir_path),
+      IN_CLOSE_WRITE | IN_MOVED_TO | IN_MASK_ADD);
+
+  if (wd != -1) {
+    struct hikari_config_watch_entry *entry =
+        hikari_malloc(sizeof(struct hikari_config_watch_entry));
+
+    entry->wd = wd;
+    entry->name = copy_path(basename(base_path));
+    entry->kind = kind;
+
+    wl_list_insert(&watch->entries, &entry->link);
+  }
+
+  hikari_free(dir_path);
+  hikari_free(base_path);
+}
+
+static bool
+shares_wd(struct wl_list *entries, int wd)
+{
+  struct hikari_config_watch_entry *entry;
+  wl_list_for_each (entry, entries, link) {
+    if (entry->wd == wd) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+static void
+clear_entries(struct hikari_config_watch *watch, struct wl_list *entries)
+{
+  struct hikari_config_watch_entry *entry, *entry_temp;
+  wl_list_for_each_safe (entry, entry_temp, entries, link) {
+    wl_list_remove(&entry->link);
+
+    // files in the same directory share a watch descriptor
+    if (!shares_wd(&watch->entries, entry->wd) &&
+        !shares_wd(&watch->xkb_entries, entry->wd)) {
+      inotify_rm_watch(watch->fd, entry->wd);
+    }
+
+    hikari_free(entry->name);
+    hikari_free(entry);
+  }
+}
+
+// inotify does not recurse, watch every directory below the XKB include paths
+// that rules, components or vendor specific symbols are looked up in
+static void
+watch_xkb_directory(
+    struct hikari_config_watch *watch, const char *path, int depth)
+{
+  int wd = inotify_add_watch(watch->fd,
+      path,
+      IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | IN_DELETE |
+          IN_ONLYDIR | IN_MASK_ADD);
+
+  if (wd == -1) {
+    return;
+  }
+
+  struct hikari_config_watch_entry *entry =
+      hikari_malloc(sizeof(struct hikari_config_watch_entry));
+
+  entry->wd = wd;
+  entry->name = NULL;
+  entry->kind = HIKARI_CONFIG_WATCH_KIND_XKB;
+
+  wl_list_insert(&watch->xkb_entries, &entry->link);
+
+  if (depth == 0) {
+    return;
+  }
+
+  DIR *dir = opendir(path);
+
+  if (dir == NULL) {
+    return;
+  }
+
+  struct dirent *dirent;
+  char child[PATH_MAX];
+  struct stat st;
+
+  while ((dirent = readdir(dir)) != NULL) {
+    if (!strcmp(dirent->d_name, ".") || !strcmp(dirent->d_name, "..")) {
+      continue;
+    }
+
+    int len = snprintf(child, sizeof(child), "%s/%s", path, dirent->d_name);
+    if (len < 0 || (size_t)len >= sizeof(child)) {
+      continue;
+    }
+
+    if (dirent->d_type == DT_DIR ||
+        ((dirent->d_type == DT_UNKNOWN || dirent->d_type == DT_LNK) &&
+            stat(child, &st) == 0 && S_ISDIR(st.st_mode))) {
+      watch_xkb_directory(watch, child, depth - 1);
+    }
+  }
+
+  closedir(dir);
+}
+
+static void
+watch_xkb(struct hikari_config_watch *watch)
+{
+  struct xkb_context *context = hikari_keymap_cache_context();
+  unsigned int nr_of_include_paths = xkb_context_num_include_paths(context);
+
+  for (unsigned int i = 0; i < nr_of_include_paths; i++) {
+    watch_xkb_directory(watch, xkb_context_include_path_get(context, i), 2);
+  }
+}
+
+static void
+reload_backgrounds(void)
+{
+  struct hikari_output *output;
+  wl_list_for_each (output, &hikari_server.outputs, server_outputs) {
+    struct hikari_output_config *output_config =
+        hikari_configuration_resolve_output_config(
+            hikari_configuration, output->wlr_output->name);
+
+    if (output_config != NULL && output_config->background.value != NULL) {
+      hikari_output_load_background(output,
+          output_config->background.value,
+          output_config->background_fit.value);
+    }
+  }
+}
+
+static int
+debounce_handler(void *data)
+{
+  struct hikari_config_watch *watch = data;
+  uint32_t pending = watch->pending;
+
+  // reloading replaces bindings and layouts a mode might still refer to,
+  // hikari_config_watch_resume picks this up again in normal mode
+  if (!hikari_server_in_normal_mode()) {
+    return 0;
+  }
+
+  watch->pending = 0;
+
+  if (pending & HIKARI_CONFIG_WATCH_KIND_XKB) {
+    hikari_keymap_cache_invalidate();
+  }
+
+  if (pending &
+      (HIKARI_CONFIG_WATCH_KIND_KEYMAP | HIKARI_CONFIG_WATCH_KIND_XKB)) {
+    hikari_configuration_invalidate(
+        hikari_configuration, HIKARI_CONFIGURATION_SECTION_KEYBOARDS);
+  }
+
+  if (pending & (HIKARI_CONFIG_WATCH_KIND_CONFIGURATION |
+                    HIKARI_CONFIG_WATCH_KIND_KEYMAP |
+                    HIKARI_CONFIG_WATCH_KIND_XKB)) {
+    if (!hikari_configuration_reload(hikari_server.config_path)) {
+      fprintf(stderr, "keeping running configuration\n");
+    }
+  }
+
+  if (pending & HIKARI_CONFIG_WATCH_KIND_BACKGROUND) {
+    reload_backgrounds();
+  }
+
+  hikari_config_watch_update(watch);
+
+  return 0;
+}
+
+static int
+inotify_handler(int fd, uint32_t mask, void *data)
+{
+  struct hikari_config_watch *watch = data;
+  char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+  ssize_t len;
+
+  while ((len = read(fd, buf, sizeof(buf))) > 0) {
+    const struct inotify_event *event;
+
+    for (char *ptr = buf; ptr < buf + len;
+         ptr += sizeof(struct inotify_event) + event->len) {
+      event = (const struct inotify_event *)ptr;
+
+      if (event->len == 0) {
+        continue;
+      }
+
+      struct hikari_config_watch_entry *entry;
+      wl_list_for_each (entry, &watch->entries, link) {
+        if (entry->wd == event->wd && !strcmp(entry->name, event->name)) {
+          watch->pending |= entry->kind;
+        }
+      }
+
+      wl_list_for_each (entry, &watch->xkb_entries, link) {
+        if (entry->wd == event->wd) {
+          watch->pending |= entry->kind;
+        }
+      }
+    }
+  }
+
+  if (watch->pending != 0) {
+    wl_event_source_timer_update(
+        watch->debounce, HIKARI_CONFIG_WATCH_DEBOUNCE);
+  }
+
+  return 0;
+}
+
+void
+hikari_config_watch_init(
+    struct hikari_config_watch *watch, struct wl_event_loop *event_loop)
+{
+  wl_list_init(&watch->entries);
+  wl_list_init(&watch->xkb_entries);
+
+  watch->pending = 0;
+  watch->event_source = NULL;
+  watch->debounce = NULL;
+
+  watch->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (watch->fd == -1) {
+    fprintf(stderr, "could not watch configuration\n");
+    return;
+  }
+
+  watch->event_source = wl_event_loop_add_fd(
+      event_loop, watch->fd, WL_EVENT_READABLE, inotify_handler, watch);
+  watch->debounce =
+      wl_event_loop_add_timer(event_loop, debounce_handler, watch);
+
+  // the include paths stay the same for the lifetime of the compositor
+  watch_xkb(watch);
+  hikari_config_watch_update(watch);
+}
+
+void
+hikari_config_watch_fini(struct hikari_config_watch *watch)
+{
+  if (watch->fd == -1) {
+    return;
+  }
+
+  clear_entries(watch, &watch->entries);
+  clear_entries(watch, &watch->xkb_entries);
+
+  wl_event_source_remove(watch->debounce);
+  wl_event_source_remove(watch->event_source);
+
+  close(watch->fd);
+}
+
+void
+hikari_config_watch_update(struct hikari_config_watch *watch)
+{
+  if (watch->fd == -1) {
+    return;
+  }
+
+  clear_entries(watch, &watch->entries);
+
+  watch_file(
+      watch, hikari_server.config_path, HIKARI_CONFIG_WATCH_KIND_CONFIGURATION);
+
+  struct hikari_keyboard_config *keyboard_config;
+  wl_list_for_each (
+      keyboard_config, &hikari_configuration->keyboard_configs, link) {
+    if (keyboard_config->xkb_file != NULL) {
+      watch_file(
+          watch, keyboard_config->xkb_file, HIKARI_CONFIG_WATCH_KIND_KEYMAP);
+    }
+  }
+
+  struct hikari_output_config *output_config;
+  wl_list_for_each (output_config, &hikari_configuration->output_configs, link) {
+    if (output_config->background.value != NULL) {
+      watch_file(watch,
+          output_config->background.value,
+          HIKARI_CONFIG_WATCH_KIND_BACKGROUND);
+    }
+  }
+}
+
+void
+hikari_config_watch_resume(struct hikari_config_watch *watch)
+{
+  if (watch->debounce == NULL || watch->pending == 0) {
+    return;
+  }
+
+  wl_event_source_timer_update(watch->debounce, 1);
+}
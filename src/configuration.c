@@ -15,12 +15,14 @@
 #include <hikari/binding_config.h>
 #include <hikari/color.h>
 #include <hikari/command.h>
+#include <hikari/config_cache.h>
 #include <hikari/exec.h>
 #include <hikari/geometry.h>
 #include <hikari/keyboard.h>
 #include <hikari/keyboard_config.h>
 #include <hikari/layout.h>
 #include <hikari/layout_config.h>
+#include <hikari/layout_generator.h>
 #include <hikari/mark.h>
 #include <hikari/memory.h>
 #include <hikari/output.h>
@@ -84,6 +86,7 @@ parse_container(
   bool explicit_nr_of_views = false;
   bool override_nr_of_views = false;
   const char *layout_func_name;
+  const char *generator_path = NULL;
   const ucl_object_t *cur;
 
   ucl_object_iter_t it = ucl_object_iterate_new(container_obj);
@@ -101,6 +104,13 @@ parse_container(
               layout_func_name, &layout_func, &views, &explicit_nr_of_views)) {
         goto done;
       }
+    } else if (!strcmp(key, "generator")) {
+      if (!ucl_object_tostring_safe(cur, &generator_path)) {
+        fprintf(stderr,
+            "configuration error: expected string for container "
+            "\"generator\"\n");
+        goto done;
+      }
     } else if (!strcmp(key, "views")) {
       override_nr_of_views = true;
       if (explicit_nr_of_views) {
@@ -130,8 +140,21 @@ parse_container(
     }
   }
 
+  if (generator_path != NULL) {
+    if (layout_func != NULL) {
+      fprintf(stderr,
+          "configuration error: container cannot have \"layout\" and "
+          "\"generator\"\n");
+      goto done;
+    }
+
+    layout_func = hikari_sheet_grid_layout;
+  }
+
   if (layout_func == NULL) {
-    fprintf(stderr, "configuration error: container expects \"layout\"\n");
+    fprintf(stderr,
+        "configuration error: container expects \"layout\" or "
+        "\"generator\"\n");
     goto done;
   }
 
@@ -146,6 +169,10 @@ parse_container(
   ret = hikari_malloc(sizeof(struct hikari_split_container));
   hikari_split_container_init(ret, views, layout_func);
 
+  if (generator_path != NULL) {
+    ret->generator = hikari_layout_generator_create(generator_path);
+  }
+
   success = true;
 
 done:
@@ -227,7 +254,8 @@ parse_split(const ucl_object_t *split_obj, struct hikari_split **split)
     const ucl_object_t *right = ucl_object_lookup(split_obj, "right");
     const ucl_object_t *top = ucl_object_lookup(split_obj, "top");
     const ucl_object_t *bottom = ucl_object_lookup(split_obj, "bottom");
-    const ucl_object_t *layout = ucl_object_lookup(split_obj, "layout");
+    const ucl_object_t *layout =
+        ucl_object_lookup_any(split_obj, "layout", "generator", NULL);
 
     if (split_is_vertical(top, bottom, left, right, layout)) {
       if (!parse_vertical(split_obj, &ret)) {
@@ -1534,6 +1562,23 @@ parse_step(
   return true;
 }
 
+static bool
+parse_animation(struct hikari_configuration *configuration,
+    const ucl_object_t *animation_obj)
+{
+  int64_t duration;
+
+  if (!ucl_object_toint_safe(animation_obj, &duration) || duration < 0) {
+    fprintf(
+        stderr, "configuration error: expected integer for \"animation\"\n");
+    return false;
+  }
+
+  configuration->animation_duration = duration;
+
+  return true;
+}
+
 static bool
 parse_font(
     struct hikari_configuration *configuration, const ucl_object_t *font_obj)
@@ -1581,6 +1626,49 @@ parse_ui(struct hikari_configuration *configuration, const ucl_object_t *ui_obj)
       if (!parse_step(configuration, cur)) {
         goto done;
       }
+    } else if (!strcmp(key, "animation")) {
+      if (!parse_animation(configuration, cur)) {
+        goto done;
+      }
+    }
+  }
+
+  success = true;
+
+done:
+  ucl_object_iterate_free(it);
+
+  return success;
+}
+
+static bool
+parse_idle(
+    struct hikari_configuration *configuration, const ucl_object_t *idle_obj)
+{
+  bool success = false;
+  ucl_object_iter_t it = ucl_object_iterate_new(idle_obj);
+
+  const ucl_object_t *cur;
+  while ((cur = ucl_object_iterate_safe(it, false)) != NULL) {
+    const char *key = ucl_object_key(cur);
+    int64_t timeout;
+
+    if (!strcmp(key, "standby") || !strcmp(key, "power-off")) {
+      if (!ucl_object_toint_safe(cur, &timeout) || timeout < 0) {
+        fprintf(
+            stderr, "configuration error: expected integer for \"%s\"\n", key);
+        goto done;
+      }
+
+      if (!strcmp(key, "standby")) {
+        configuration->idle_standby = timeout;
+      } else {
+        configuration->idle_power_off = timeout;
+      }
+    } else {
+      fprintf(
+          stderr, "configuration error: unknown \"idle\" key \"%s\"\n", key);
+      goto done;
     }
   }
 
@@ -1616,26 +1704,62 @@ set_env_vars(struct ucl_parser *parser)
   return true;
 }
 
+static void
+hash_sections(struct hikari_configuration *configuration,
+    const ucl_object_t *configuration_obj)
+{
+  static const char *paths[HIKARI_NR_OF_CONFIGURATION_SECTIONS] = {
+    [HIKARI_CONFIGURATION_SECTION_UI] = "ui",
+    [HIKARI_CONFIGURATION_SECTION_ACTIONS] = "actions",
+    [HIKARI_CONFIGURATION_SECTION_LAYOUTS] = "layouts",
+    [HIKARI_CONFIGURATION_SECTION_VIEWS] = "views",
+    [HIKARI_CONFIGURATION_SECTION_MARKS] = "marks",
+    [HIKARI_CONFIGURATION_SECTION_BINDINGS] = "bindings",
+    [HIKARI_CONFIGURATION_SECTION_OUTPUTS] = "outputs",
+    [HIKARI_CONFIGURATION_SECTION_POINTERS] = "inputs.pointers",
+    [HIKARI_CONFIGURATION_SECTION_KEYBOARDS] = "inputs.keyboards",
+    [HIKARI_CONFIGURATION_SECTION_SWITCHES] = "inputs.switches",
+    [HIKARI_CONFIGURATION_SECTION_IDLE] = "idle",
+  };
+
+  for (int i = 0; i < HIKARI_NR_OF_CONFIGURATION_SECTIONS; i++) {
+    configuration->sections[i] = hikari_config_cache_hash_object(
+        ucl_object_lookup_path(configuration_obj, paths[i]));
+  }
+}
+
 bool
 hikari_configuration_load(
     struct hikari_configuration *configuration, char *config_path)
 {
-  struct ucl_parser *parser = ucl_parser_new(0);
-  if (!set_env_vars(parser)) {
-    ucl_parser_free(parser);
-    return false;
-  }
+  struct ucl_parser *parser = NULL;
+  struct hikari_config_cache cache;
   bool success = false;
   const ucl_object_t *cur;
 
-  ucl_parser_add_file(parser, config_path);
-  ucl_object_t *configuration_obj = ucl_parser_get_object(parser);
+  hikari_config_cache_init(&cache, config_path);
+
+  ucl_object_t *configuration_obj =
+      hikari_config_cache_load(&cache, configuration->sections);
 
   if (configuration_obj == NULL) {
-    const char *error = ucl_parser_get_error(parser);
-    fprintf(stderr, "%s\n", error);
-    ucl_parser_free(parser);
-    return false;
+    parser = ucl_parser_new(0);
+    if (!set_env_vars(parser)) {
+      ucl_parser_free(parser);
+      hikari_config_cache_fini(&cache);
+      return false;
+    }
+
+    ucl_parser_add_file(parser, config_path);
+    configuration_obj = ucl_parser_get_object(parser);
+
+    if (configuration_obj == NULL) {
+      const char *error = ucl_parser_get_error(parser);
+      fprintf(stderr, "%s\n", error);
+      ucl_parser_free(parser);
+      hikari_config_cache_fini(&cache);
+      return false;
+    }
   }
 
   ucl_object_iter_t it = ucl_object_iterate_new(configuration_obj);
@@ -1681,6 +1805,10 @@ hikari_configuration_load(
       if (!parse_inputs(configuration, cur)) {
         goto done;
       }
+    } else if (!strcmp(key, "idle")) {
+      if (!parse_idle(configuration, cur)) {
+        goto done;
+      }
     } else if (!!strcmp(key, "actions") && !!strcmp(key, "layouts")) {
       fprintf(stderr,
           "configuration error: unkown configuration section \"%s\"\n",
@@ -1693,16 +1821,87 @@ hikari_configuration_load(
     goto done;
   }
 
+  if (parser != NULL) {
+    hash_sections(configuration, configuration_obj);
+    hikari_config_cache_store(
+        &cache, configuration_obj, configuration->sections);
+  }
+
   success = true;
 
 done:
   ucl_object_iterate_free(it);
   ucl_object_unref(configuration_obj);
-  ucl_parser_free(parser);
+  if (parser != NULL) {
+    ucl_parser_free(parser);
+  }
+  hikari_config_cache_fini(&cache);
 
   return success;
 }
 
+static void
+swap_lists(struct wl_list *first, struct wl_list *second)
+{
+  struct wl_list tmp;
+
+  wl_list_init(&tmp);
+  wl_list_insert_list(&tmp, first);
+  wl_list_init(first);
+  wl_list_insert_list(first, second);
+  wl_list_init(second);
+  wl_list_insert_list(second, &tmp);
+}
+
+static bool
+background_changed(struct hikari_output_config *old_output_config,
+    struct hikari_output_config *output_config)
+{
+  char *old_background =
+      old_output_config != NULL ? old_output_config->background.value : NULL;
+  char *background =
+      output_config != NULL ? output_config->background.value : NULL;
+
+  if (old_background == NULL || background == NULL) {
+    return old_background != background;
+  }
+
+  return strcmp(old_background, background) ||
+         old_output_config->background_fit.value !=
+             output_config->background_fit.value;
+}
+
+static void
+reconfigure_output(struct hikari_output *output,
+    struct hikari_output_config *old_output_config,
+    struct hikari_output_config *output_config)
+{
+  if (output_config == NULL) {
+    return;
+  }
+
+  if (output_config->position.value.type ==
+      HIKARI_POSITION_CONFIG_TYPE_ABSOLUTE) {
+    int x = output_config->position.value.config.absolute.x;
+    int y = output_config->position.value.config.absolute.y;
+
+    if (output->geometry.x != x || output->geometry.y != y) {
+      hikari_output_move(output, x, y);
+    }
+  }
+
+  if (output_config->background.value != NULL &&
+      background_changed(old_output_config, output_config)) {
+    hikari_output_load_background(output,
+        output_config->background.value,
+        output_config->background_fit.value);
+  }
+}
+
+#define CHANGED(name)                                                          \
+  (configuration->sections[HIKARI_CONFIGURATION_SECTION_##name] !=             \
+      old_configuration->sections[HIKARI_CONFIGURATION_SECTION_##name])
+
 bool
 hikari_configuration_reload(char *config_path)
 {
@@ -1714,88 +1913,121 @@ hikari_configuration_reload(char *config_path)
   bool success = hikari_configuration_load(configuration, config_path);
 
   if (success) {
-    if (hikari_server.workspace->focus_view != NULL) {
+    struct hikari_configuration *old_configuration = hikari_configuration;
+
+    bool ui_changed = CHANGED(UI);
+    bool bindings_changed = CHANGED(BINDINGS) || CHANGED(ACTIONS);
+    bool keyboards_changed = CHANGED(KEYBOARDS);
+    bool geometry_changed = configuration->border != old_configuration->border;
+
+    if (ui_changed && hikari_server.workspace->focus_view != NULL) {
       hikari_indicator_damage(
           &hikari_server.indicator, hikari_server.workspace->focus_view);
     }
 
-    hikari_configuration_fini(hikari_configuration);
-    hikari_free(hikari_configuration);
+    if (!bindings_changed) {
+      swap_lists(&configuration->keyboard_binding_configs,
+          &old_configuration->keyboard_binding_configs);
+      swap_lists(&configuration->mouse_binding_configs,
+          &old_configuration->mouse_binding_configs);
+      swap_lists(&configuration->action_configs,
+          &old_configuration->action_configs);
+    }
+
     hikari_configuration = configuration;
 
-    struct hikari_pointer *pointer;
-    wl_list_for_each (pointer, &hikari_server.pointers, server_pointers) {
-      struct hikari_pointer_config *pointer_config =
-          hikari_configuration_resolve_pointer_config(
-              hikari_configuration, pointer->device->name);
+    if (CHANGED(POINTERS)) {
+      struct hikari_pointer *pointer;
+      wl_list_for_each (pointer, &hikari_server.pointers, server_pointers) {
+        struct hikari_pointer_config *pointer_config =
+            hikari_configuration_resolve_pointer_config(
+                hikari_configuration, pointer->device->name);
 
-      if (pointer_config != NULL) {
-        hikari_pointer_configure(pointer, pointer_config);
+        if (pointer_config != NULL) {
+          hikari_pointer_configure(pointer, pointer_config);
+        }
       }
     }
 
-    hikari_cursor_configure_bindings(
-        &hikari_server.cursor, &configuration->mouse_binding_configs);
+    if (bindings_changed) {
+      hikari_cursor_configure_bindings(
+          &hikari_server.cursor, &configuration->mouse_binding_configs);
+    }
 
-    struct hikari_keyboard *keyboard;
-    wl_list_for_each (keyboard, &hikari_server.keyboards, server_keyboards) {
-      struct hikari_keyboard_config *keyboard_config =
-          hikari_configuration_resolve_keyboard_config(
-              hikari_configuration, keyboard->device->name);
+    if (keyboards_changed || bindings_changed) {
+      struct hikari_keyboard *keyboard;
+      wl_list_for_each (keyboard, &hikari_server.keyboards, server_keyboards) {
+        if (keyboards_changed) {
+          struct hikari_keyboard_config *keyboard_config =
+              hikari_configuration_resolve_keyboard_config(
+                  hikari_configuration, keyboard->device->name);
 
-      assert(keyboard_config != NULL);
-      hikari_keyboard_configure(keyboard, keyboard_config);
+          assert(keyboard_config != NULL);
+          hikari_keyboard_configure(keyboard, keyboard_config);
+        }
 
-      hikari_keyboard_configure_bindings(
-          keyboard, &configuration->keyboard_binding_configs);
+        hikari_keyboard_configure_bindings(
+            keyboard, &configuration->keyboard_binding_configs);
+      }
     }
 
     struct hikari_output *output;
     wl_list_for_each (output, &hikari_server.outputs, server_outputs) {
-      struct hikari_view *view;
-      wl_list_for_each (view, &output->views, output_views) {
-        hikari_view_refresh_geometry(view, view->current_geometry);
+      if (geometry_changed) {
+        struct hikari_view *view;
+        wl_list_for_each (view, &output->views, output_views) {
+          hikari_view_refresh_geometry(view, view->current_geometry);
+        }
       }
 
-      struct hikari_output_config *output_config =
-          hikari_configuration_resolve_output_config(
-              hikari_configuration, output->wlr_output->name);
+      if (CHANGED(OUTPUTS)) {
+        const char *output_name = output->wlr_output->name;
 
-      if (output_config != NULL) {
-        if (output_config->position.value.type ==
-            HIKARI_POSITION_CONFIG_TYPE_ABSOLUTE) {
-          int x = output_config->position.value.config.absolute.x;
-          int y = output_config->position.value.config.absolute.y;
+        reconfigure_output(output,
+            hikari_configuration_resolve_output_config(
+                old_configuration, output_name),
+            hikari_configuration_resolve_output_config(
+                hikari_configuration, output_name));
+      }
 
-          if (output->geometry.x != x || output->geometry.y != y) {
-            hikari_output_move(output, x, y);
-          }
-        }
+      if (ui_changed && output->enabled) {
+        hikari_output_damage_whole(output);
+      }
+    }
 
-        if (output_config->background.value != NULL) {
-          hikari_output_load_background(output,
-              output_config->background.value,
-              output_config->background_fit.value);
+    if (CHANGED(SWITCHES)) {
+      struct hikari_switch *swtch;
+      wl_list_for_each (swtch, &hikari_server.switches, server_switches) {
+        struct hikari_switch_config *switch_config =
+            hikari_configuration_resolve_switch_config(
+                hikari_configuration, swtch->device->name);
+
+        if (switch_config != NULL) {
+          hikari_switch_configure(swtch, switch_config);
+        } else {
+          hikari_switch_reset(swtch);
         }
       }
     }
 
-    struct hikari_switch *swtch;
-    wl_list_for_each (swtch, &hikari_server.switches, server_switches) {
-      struct hikari_switch_config *switch_config =
-          hikari_configuration_resolve_switch_config(
-              hikari_configuration, swtch->device->name);
-
-      if (switch_config != NULL) {
-        hikari_switch_configure(swtch, switch_config);
-      } else {
-        hikari_switch_reset(swtch);
-      }
+#ifdef HAVE_IDLE
+    if (CHANGED(IDLE)) {
+      hikari_idle_configure(&hikari_server.idle);
     }
+#endif
 
-    if (hikari_server.workspace->focus_view != NULL) {
-      hikari_indicator_update(
-          &hikari_server.indicator, hikari_server.workspace->focus_view);
+    hikari_configuration_fini(old_configuration);
+    hikari_free(old_configuration);
+
+    if (ui_changed) {
+      hikari_indicator_fini(&hikari_server.indicator);
+      hikari_indicator_init(
+          &hikari_server.indicator, hikari_configuration->indicator_selected);
+
+      if (hikari_server.workspace->focus_view != NULL) {
+        hikari_indicator_update(
+            &hikari_server.indicator, hikari_server.workspace->focus_view);
+      }
     }
   } else {
     hikari_configuration_fini(configuration);
@@ -1804,6 +2036,14 @@ hikari_configuration_reload(char *config_path)
 
   return success;
 }
+#undef CHANGED
+
+void
+hikari_configuration_invalidate(struct hikari_configuration *configuration,
+    enum hikari_configuration_section section)
+{
+  configuration->sections[section] = 0;
+}
 
 void
 hikari_configuration_init(struct hikari_configuration *configuration)
@@ -1833,6 +2073,14 @@ hikari_configuration_init(struct hikari_configuration *configuration)
   configuration->border = 1;
   configuration->gap = 5;
   configuration->step = 100;
+  configuration->animation_duration = 0;
+
+  configuration->idle_standby = 0;
+  configuration->idle_power_off = 0;
+
+  for (int i = 0; i < HIKARI_NR_OF_CONFIGURATION_SECTIONS; i++) {
+    configuration->sections[i] = 0;
+  }
 
   for (int i = 0; i < HIKARI_NR_OF_EXECS; i++) {
     hikari_exec_init(&configuration->execs[i]);
@@ -3,6 +3,7 @@
 #include <assert.h>
 #include <errno.h>
 
+#include <wlr/types/wlr_output_layout.h>
 #include <wlr/types/wlr_seat.h>
 #include <wlr/types/wlr_xcursor_manager.h>
 
@@ -11,6 +12,7 @@
 #include <hikari/memory.h>
 #include <hikari/output.h>
 #include <hikari/server.h>
+#include <hikari/trace.h>
 
 static void
 motion_absolute_handler(struct wl_listener *listener, void *data);
@@ -122,6 +124,8 @@ hikari_cursor_init(
   wlr_xcursor_manager_load(cursor->cursor_mgr, 1);
 
   cursor->wlr_cursor = wlr_cursor;
+  cursor->image = NULL;
+  cursor->surface = NULL;
 
   wl_list_init(&cursor->surface_destroy.link);
   hikari_binding_group_init(cursor->bindings);
@@ -188,9 +192,17 @@ hikari_cursor_deactivate(struct hikari_cursor *cursor)
 void
 hikari_cursor_set_image(struct hikari_cursor *cursor, const char *path)
 {
+  if (cursor->surface == NULL && cursor->image != NULL && path != NULL &&
+      !strcmp(cursor->image, path)) {
+    return;
+  }
+
   wl_list_remove(&cursor->surface_destroy.link);
   wl_list_init(&cursor->surface_destroy.link);
 
+  cursor->image = path;
+  cursor->surface = NULL;
+
   if (path != NULL) {
     wlr_xcursor_manager_set_cursor_image(
         cursor->cursor_mgr, path, cursor->wlr_cursor);
@@ -210,9 +222,31 @@ hikari_cursor_center(struct hikari_cursor *cursor,
   hikari_cursor_warp(cursor, x, y);
 }
 
+static void
+account_cursor_update(struct hikari_cursor *cursor)
+{
+  struct wlr_cursor *wlr_cursor = cursor->wlr_cursor;
+  struct wlr_output *wlr_output = wlr_output_layout_output_at(
+      hikari_server.output_layout, wlr_cursor->x, wlr_cursor->y);
+
+  if (wlr_output == NULL) {
+    return;
+  }
+
+  struct hikari_output *output = wlr_output->data;
+
+  if (wlr_output->hardware_cursor != NULL) {
+    output->cursor_stats.hardware++;
+  } else {
+    output->cursor_stats.software++;
+  }
+}
+
 static void
 motion_absolute_handler(struct wl_listener *listener, void *data)
 {
+  HIKARI_TRACE_SCOPE("cursor_motion");
+
   struct hikari_cursor *cursor =
       wl_container_of(listener, cursor, motion_absolute);
 
@@ -220,8 +254,17 @@ motion_absolute_handler(struct wl_listener *listener, void *data)
 
   struct wlr_event_pointer_motion_absolute *event = data;
 
+#ifdef HAVE_RECORD
+  hikari_recorder_motion_absolute(&hikari_server.recorder, event);
+#endif
+
+#ifdef HAVE_IDLE
+  hikari_idle_notify_activity(&hikari_server.idle);
+#endif
+
   wlr_cursor_warp_absolute(
       cursor->wlr_cursor, event->device, event->x, event->y);
+  account_cursor_update(cursor);
 
   hikari_server.mode->cursor_move(event->time_msec);
 }
@@ -231,20 +274,36 @@ frame_handler(struct wl_listener *listener, void *data)
 {
   assert(!hikari_server_in_lock_mode());
 
+#ifdef HAVE_RECORD
+  hikari_recorder_mark(
+      &hikari_server.recorder, HIKARI_RECORDER_EVENT_FRAME, 0, 0, 0);
+#endif
+
   wlr_seat_pointer_notify_frame(hikari_server.seat);
 }
 
 static void
 motion_handler(struct wl_listener *listener, void *data)
 {
+  HIKARI_TRACE_SCOPE("cursor_motion");
+
   struct hikari_cursor *cursor = wl_container_of(listener, cursor, motion);
 
   assert(!hikari_server_in_lock_mode());
 
   struct wlr_event_pointer_motion *event = data;
 
+#ifdef HAVE_RECORD
+  hikari_recorder_motion(&hikari_server.recorder, event);
+#endif
+
+#ifdef HAVE_IDLE
+  hikari_idle_notify_activity(&hikari_server.idle);
+#endif
+
   wlr_cursor_move(
       cursor->wlr_cursor, event->device, event->delta_x, event->delta_y);
+  account_cursor_update(cursor);
 
   hikari_server.mode->cursor_move(event->time_msec);
 }
@@ -257,6 +316,14 @@ button_handler(struct wl_listener *listener, void *data)
   struct hikari_cursor *cursor = wl_container_of(listener, cursor, button);
   struct wlr_event_pointer_button *event = data;
 
+#ifdef HAVE_RECORD
+  hikari_recorder_button(&hikari_server.recorder, event);
+#endif
+
+#ifdef HAVE_IDLE
+  hikari_idle_notify_activity(&hikari_server.idle);
+#endif
+
   hikari_server.mode->button_handler(cursor, event);
 }
 
@@ -267,6 +334,14 @@ axis_handler(struct wl_listener *listener, void *data)
 
   struct wlr_event_pointer_axis *event = data;
 
+#ifdef HAVE_RECORD
+  hikari_recorder_axis(&hikari_server.recorder, event);
+#endif
+
+#ifdef HAVE_IDLE
+  hikari_idle_notify_activity(&hikari_server.idle);
+#endif
+
   wlr_seat_pointer_notify_axis(hikari_server.seat,
       event->time_msec,
       event->orientation,
@@ -301,6 +376,17 @@ request_set_cursor_handler(struct wl_listener *listener, void *data)
 
   struct wlr_surface *surface = event->surface;
 
+  if (surface != NULL && surface == cursor->surface &&
+      event->hotspot_x == cursor->hotspot_x &&
+      event->hotspot_y == cursor->hotspot_y) {
+    return;
+  }
+
+  cursor->image = NULL;
+  cursor->surface = surface;
+  cursor->hotspot_x = event->hotspot_x;
+  cursor->hotspot_y = event->hotspot_y;
+
   wl_list_remove(&cursor->surface_destroy.link);
   if (surface != NULL) {
     cursor->surface_destroy.notify = surface_destroy_handler;
@@ -319,5 +405,7 @@ surface_destroy_handler(struct wl_listener *listener, void *data)
   struct hikari_cursor *cursor =
       wl_container_of(listener, cursor, surface_destroy);
 
+  cursor->surface = NULL;
+
   hikari_cursor_reset_image(cursor);
 }
@@ -0,0 +1,162 @@
+#include <hikari/damage_overlay.h>
+
+#include <wlr/render/wlr_renderer.h>
+#include <wlr/types/wlr_matrix.h>
+#include <wlr/types/wlr_output.h>
+#include <wlr/types/wlr_output_damage.h>
+
+#include <hikari/output.h>
+#include <hikari/renderer.h>
+#include <hikari/server.h>
+
+static float damage_color[4] = { 0.2, 0.2, 0.0, 0.2 };
+static float overdraw_color[4] = { 0.15, 0.0, 0.0, 0.15 };
+static float flash_color[4] = { 0.8, 0.0, 0.8, 0.8 };
+
+static int
+expire_handler(void *data)
+{
+  struct hikari_damage_overlay *overlay = data;
+  struct hikari_output *output = overlay->output;
+
+  pixman_region32_copy(&overlay->repaint, &overlay->pending);
+  pixman_region32_clear(&overlay->pending);
+
+  if (output->enabled) {
+    wlr_output_damage_add(output->damage, &overlay->repaint);
+  }
+
+  return 0;
+}
+
+void
+hikari_damage_overlay_init(
+    struct hikari_damage_overlay *overlay, struct hikari_output *output)
+{
+  overlay->output = output;
+  overlay->expire = wl_event_loop_add_timer(
+      hikari_server.event_loop, expire_handler, overlay);
+  overlay->flash = false;
+
+  for (int i = 0; i < HIKARI_DAMAGE_OVERLAY_LEVELS; i++) {
+    pixman_region32_init(&overlay->drawn[i]);
+  }
+  pixman_region32_init(&overlay->pending);
+  pixman_region32_init(&overlay->repaint);
+}
+
+void
+hikari_damage_overlay_fini(struct hikari_damage_overlay *overlay)
+{
+  wl_event_source_remove(overlay->expire);
+
+  for (int i = 0; i < HIKARI_DAMAGE_OVERLAY_LEVELS; i++) {
+    pixman_region32_fini(&overlay->drawn[i]);
+  }
+  pixman_region32_fini(&overlay->pending);
+  pixman_region32_fini(&overlay->repaint);
+}
+
+void
+hikari_damage_overlay_begin(struct hikari_damage_overlay *overlay)
+{
+  for (int i = 0; i < HIKARI_DAMAGE_OVERLAY_LEVELS; i++) {
+    pixman_region32_clear(&overlay->drawn[i]);
+  }
+}
+
+void
+hikari_damage_overlay_account(
+    struct hikari_damage_overlay *overlay, pixman_region32_t *region)
+{
+  pixman_region32_t overdrawn;
+  pixman_region32_init(&overdrawn);
+
+  for (int i = HIKARI_DAMAGE_OVERLAY_LEVELS - 1; i > 0; i--) {
+    pixman_region32_intersect(&overdrawn, &overlay->drawn[i - 1], region);
+    pixman_region32_union(&overlay->drawn[i], &overlay->drawn[i], &overdrawn);
+  }
+  pixman_region32_union(&overlay->drawn[0], &overlay->drawn[0], region);
+
+  pixman_region32_fini(&overdrawn);
+}
+
+static void
+tint(struct hikari_damage_overlay *overlay,
+    pixman_region32_t *region,
+    float color[static 4],
+    struct hikari_renderer *renderer)
+{
+  struct wlr_output *wlr_output = renderer->wlr_output;
+  struct wlr_renderer *wlr_renderer = renderer->wlr_renderer;
+
+  pixman_region32_t visible;
+  pixman_region32_init(&visible);
+  pixman_region32_subtract(&visible, region, &overlay->repaint);
+
+  if (!pixman_region32_not_empty(&visible)) {
+    goto done;
+  }
+
+  struct wlr_box box = { .x = 0, .y = 0 };
+  wlr_output_transformed_resolution(wlr_output, &box.width, &box.height);
+
+  float matrix[9];
+  wlr_matrix_project_box(matrix,
+      &box,
+      WL_OUTPUT_TRANSFORM_NORMAL,
+      0,
+      wlr_output->transform_matrix);
+
+  int nrects;
+  pixman_box32_t *rects = pixman_region32_rectangles(&visible, &nrects);
+  for (int i = 0; i < nrects; i++) {
+    hikari_renderer_scissor(wlr_output, wlr_renderer, &rects[i]);
+    wlr_render_quad_with_matrix(wlr_renderer, color, matrix);
+  }
+
+  pixman_region32_union(&overlay->pending, &overlay->pending, &visible);
+
+done:
+  pixman_region32_fini(&visible);
+}
+
+void
+hikari_damage_overlay_render(
+    struct hikari_damage_overlay *overlay, struct hikari_renderer *renderer)
+{
+  struct hikari_output *output = overlay->output;
+
+  tint(overlay, &output->damage->current, damage_color, renderer);
+
+  for (int i = 1; i < HIKARI_DAMAGE_OVERLAY_LEVELS; i++) {
+    tint(overlay, &overlay->drawn[i], overdraw_color, renderer);
+  }
+
+  if (overlay->flash) {
+    int width, height;
+    int edge = HIKARI_DAMAGE_OVERLAY_FLASH_WIDTH;
+    wlr_output_transformed_resolution(output->wlr_output, &width, &height);
+
+    pixman_region32_t frame;
+    pixman_region32_init_rect(&frame, 0, 0, width, height);
+    pixman_region32_t inner;
+    pixman_region32_init_rect(
+        &inner, edge, edge, width - 2 * edge, height - 2 * edge);
+    pixman_region32_subtract(&frame, &frame, &inner);
+
+    tint(overlay, &frame, flash_color, renderer);
+
+    pixman_region32_fini(&inner);
+    pixman_region32_fini(&frame);
+
+    overlay->flash = false;
+  }
+
+  pixman_region32_clear(&overlay->repaint);
+
+  if (pixman_region32_not_empty(&overlay->pending)) {
+    wl_event_source_timer_update(
+        overlay->expire, HIKARI_DAMAGE_OVERLAY_TIMEOUT);
+  }
+}
@@ -0,0 +1,147 @@
+#include <hikari/damage_ring.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static enum hikari_damage_ring_mode
+mode_from_env(void)
+{
+  const char *mode = getenv("HIKARI_DAMAGE");
+
+  if (mode == NULL || !strcmp(mode, "partial")) {
+    return HIKARI_DAMAGE_RING_MODE_PARTIAL;
+  } else if (!strcmp(mode, "full")) {
+    return HIKARI_DAMAGE_RING_MODE_FULL;
+  } else if (!strcmp(mode, "validate")) {
+    return HIKARI_DAMAGE_RING_MODE_VALIDATE;
+  }
+
+  fprintf(stderr, "unknown damage mode \"%s\", using \"partial\"\n", mode);
+
+  return HIKARI_DAMAGE_RING_MODE_PARTIAL;
+}
+
+void
+hikari_damage_ring_init(struct hikari_damage_ring *damage_ring)
+{
+  damage_ring->mode = mode_from_env();
+  damage_ring->head = 0;
+  damage_ring->nr_of_frames = 0;
+  damage_ring->buffer_age = 0;
+  damage_ring->full = true;
+  damage_ring->stats = (struct hikari_damage_ring_stats){ 0 };
+
+  for (int i = 0; i < HIKARI_DAMAGE_RING_SIZE; i++) {
+    struct hikari_damage_ring_frame *frame = &damage_ring->frames[i];
+
+    pixman_region32_init(&frame->damage);
+    frame->buffer_age = 0;
+    frame->full = true;
+  }
+}
+
+void
+hikari_damage_ring_fini(struct hikari_damage_ring *damage_ring)
+{
+  for (int i = 0; i < HIKARI_DAMAGE_RING_SIZE; i++) {
+    pixman_region32_fini(&damage_ring->frames[i].damage);
+  }
+}
+
+void
+hikari_damage_ring_buffer_damage(struct hikari_damage_ring *damage_ring,
+    pixman_region32_t *current,
+    int buffer_age,
+    int width,
+    int height,
+    pixman_region32_t *buffer_damage)
+{
+  struct hikari_damage_ring_stats *stats = &damage_ring->stats;
+  bool known_age =
+      buffer_age > 0 && buffer_age - 1 <= damage_ring->nr_of_frames;
+
+  stats->frames++;
+
+  if (!known_age) {
+    stats->unknown_age++;
+  }
+
+  damage_ring->buffer_age = buffer_age;
+  damage_ring->full =
+      !known_age || damage_ring->mode == HIKARI_DAMAGE_RING_MODE_FULL;
+
+  if (damage_ring->full) {
+    pixman_region32_union_rect(
+        buffer_damage, buffer_damage, 0, 0, width, height);
+    stats->full++;
+    return;
+  }
+
+  pixman_region32_copy(buffer_damage, current);
+
+  // a buffer of age n lacks the damage of the n - 1 frames after it
+  for (int i = 1; i < buffer_age; i++) {
+    int index = (damage_ring->head - i + HIKARI_DAMAGE_RING_SIZE) %
+                HIKARI_DAMAGE_RING_SIZE;
+
+    pixman_region32_union(
+        buffer_damage, buffer_damage, &damage_ring->frames[index].damage);
+  }
+
+  if (pixman_region32_n_rects(buffer_damage) > HIKARI_DAMAGE_RING_MAX_RECTS) {
+    pixman_box32_t *extents = pixman_region32_extents(buffer_damage);
+
+    pixman_region32_union_rect(buffer_damage,
+        buffer_damage,
+        extents->x1,
+        extents->y1,
+        extents->x2 - extents->x1,
+        extents->y2 - extents->y1);
+  }
+
+  pixman_box32_t rect = { .x1 = 0, .y1 = 0, .x2 = width, .y2 = height };
+  if (pixman_region32_contains_rectangle(buffer_damage, &rect) ==
+      PIXMAN_REGION_IN) {
+    damage_ring->full = true;
+    stats->full++;
+  }
+}
+
+void
+hikari_damage_ring_push(
+    struct hikari_damage_ring *damage_ring, pixman_region32_t *damage)
+{
+  struct hikari_damage_ring_frame *frame =
+      &damage_ring->frames[damage_ring->head];
+
+  pixman_region32_copy(&frame->damage, damage);
+  frame->buffer_age = damage_ring->buffer_age;
+  frame->full = damage_ring->full;
+
+  damage_ring->head = (damage_ring->head + 1) % HIKARI_DAMAGE_RING_SIZE;
+
+  if (damage_ring->nr_of_frames < HIKARI_DAMAGE_RING_SIZE) {
+    damage_ring->nr_of_frames++;
+  }
+}
+
+void
+hikari_damage_ring_validated(
+    struct hikari_damage_ring *damage_ring, const char *name, bool matches)
+{
+  struct hikari_damage_ring_stats *stats = &damage_ring->stats;
+
+  stats->validated++;
+
+  if (!matches) {
+    stats->mismatches++;
+
+    fprintf(stderr,
+        "damage validation: frame %lu on %s (buffer age %d) differs from "
+        "full repaint\n",
+        stats->frames,
+        name,
+        damage_ring->buffer_age);
+  }
+}
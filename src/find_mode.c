@@ -0,0 +1,359 @@
+#include <hikari/find_mode.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <wlr/util/box.h>
+
+#include <hikari/configuration.h>
+#include <hikari/group.h>
+#include <hikari/indicator.h>
+#include <hikari/keyboard.h>
+#include <hikari/normal_mode.h>
+#include <hikari/output.h>
+#include <hikari/renderer.h>
+#include <hikari/server.h>
+#include <hikari/sheet.h>
+#include <hikari/view.h>
+#include <hikari/view_index.h>
+#include <hikari/workspace.h>
+
+static struct hikari_find_mode *
+get_mode(void)
+{
+  struct hikari_find_mode *mode = &hikari_server.find_mode;
+
+  assert(mode == (struct hikari_find_mode *)hikari_server.mode);
+
+  return mode;
+}
+
+static void
+damage_list(struct hikari_find_mode *mode)
+{
+  struct hikari_output *output = hikari_server.workspace->output;
+  struct wlr_box origin;
+
+  hikari_find_mode_origin(output, &origin);
+
+  hikari_indicator_bar_damage(&mode->prompt, output, &origin);
+
+  for (int i = 0; i < HIKARI_FIND_MODE_MAX_RESULTS; i++) {
+    hikari_indicator_bar_damage(&mode->entries[i], output, &origin);
+  }
+}
+
+static void
+search(struct hikari_find_mode *mode)
+{
+  struct hikari_view_index *index = &hikari_server.view_index;
+
+  mode->nr_of_results = hikari_view_index_search(index,
+      mode->input_buffer.buffer,
+      mode->results,
+      HIKARI_FIND_MODE_MAX_RESULTS);
+  mode->generation = index->generation;
+
+  if (mode->selected >= mode->nr_of_results) {
+    mode->selected = 0;
+  }
+}
+
+// results hold plain view pointers, search again once views were added,
+// renamed or removed since the last search
+static void
+refresh_results(struct hikari_find_mode *mode)
+{
+  if (mode->generation != hikari_server.view_index.generation) {
+    search(mode);
+  }
+}
+
+static void
+update_list(struct hikari_find_mode *mode)
+{
+  struct hikari_output *output = hikari_server.workspace->output;
+  char *input = mode->input_buffer.buffer;
+  char text[256];
+
+  refresh_results(mode);
+  damage_list(mode);
+
+  if (!strcmp(input, "")) {
+    hikari_indicator_bar_update(&mode->prompt, output, " ");
+  } else {
+    hikari_indicator_bar_update(&mode->prompt, output, input);
+  }
+
+  for (int i = 0; i < HIKARI_FIND_MODE_MAX_RESULTS; i++) {
+    struct hikari_indicator_bar *entry = &mode->entries[i];
+
+    if (i < mode->nr_of_results) {
+      struct hikari_view *view = mode->results[i];
+
+      snprintf(text,
+          sizeof(text),
+          "%s [%s] %s",
+          view->group != NULL ? view->group->name : "",
+          view->id != NULL ? view->id : "",
+          view->title != NULL ? view->title : "");
+
+      hikari_indicator_bar_update(entry, output, text);
+    } else {
+      hikari_indicator_bar_update(entry, output, NULL);
+    }
+
+    if (i == mode->selected) {
+      hikari_indicator_bar_set_color(
+          entry, hikari_configuration->indicator_selected);
+    } else {
+      hikari_indicator_bar_set_color(
+          entry, hikari_configuration->indicator_grouped);
+    }
+  }
+
+  damage_list(mode);
+}
+
+static void
+put_char(struct hikari_input_buffer *input_buffer,
+    struct hikari_keyboard *keyboard,
+    uint32_t keycode)
+{
+  uint32_t codepoint = hikari_keyboard_get_codepoint(keyboard, keycode);
+
+  if (codepoint) {
+    hikari_input_buffer_add_utf32_char(input_buffer, codepoint);
+  }
+}
+
+static void
+select_next(struct hikari_find_mode *mode)
+{
+  refresh_results(mode);
+
+  if (mode->nr_of_results > 0) {
+    mode->selected = (mode->selected + 1) % mode->nr_of_results;
+  }
+}
+
+static void
+select_prev(struct hikari_find_mode *mode)
+{
+  refresh_results(mode);
+
+  if (mode->nr_of_results > 0) {
+    mode->selected =
+        (mode->selected + mode->nr_of_results - 1) % mode->nr_of_results;
+  }
+}
+
+static void
+confirm_find(void)
+{
+  struct hikari_find_mode *mode = get_mode();
+  struct hikari_view *view = NULL;
+
+  refresh_results(mode);
+
+  if (mode->nr_of_results > 0) {
+    view = mode->results[mode->selected];
+  }
+
+  hikari_server_enter_normal_mode(NULL);
+
+  if (view != NULL) {
+    hikari_server_switch_to_view(view);
+  }
+}
+
+static void
+handle_keysym(
+    struct hikari_keyboard *keyboard, uint32_t keycode, xkb_keysym_t sym)
+{
+  struct hikari_find_mode *mode = get_mode();
+  struct hikari_input_buffer *input_buffer = &mode->input_buffer;
+  bool ctrl = hikari_keyboard_check_modifier(keyboard, WLR_MODIFIER_CTRL);
+
+  switch (sym) {
+    case XKB_KEY_Caps_Lock:
+    case XKB_KEY_Shift_L:
+    case XKB_KEY_Shift_R:
+    case XKB_KEY_Control_L:
+    case XKB_KEY_Control_R:
+    case XKB_KEY_Meta_L:
+    case XKB_KEY_Meta_R:
+    case XKB_KEY_Alt_L:
+    case XKB_KEY_Alt_R:
+    case XKB_KEY_Super_L:
+    case XKB_KEY_Super_R:
+      goto done;
+
+    case XKB_KEY_h:
+      if (ctrl) {
+        hikari_input_buffer_remove_char(input_buffer);
+      } else {
+        put_char(input_buffer, keyboard, keycode);
+      }
+      break;
+
+    case XKB_KEY_u:
+      if (ctrl) {
+        hikari_input_buffer_clear(input_buffer);
+      } else {
+        put_char(input_buffer, keyboard, keycode);
+      }
+      break;
+
+    case XKB_KEY_w:
+      if (ctrl) {
+        hikari_input_buffer_remove_word(input_buffer);
+      } else {
+        put_char(input_buffer, keyboard, keycode);
+      }
+      break;
+
+    case XKB_KEY_BackSpace:
+      hikari_input_buffer_remove_char(input_buffer);
+      break;
+
+    case XKB_KEY_n:
+      if (!ctrl) {
+        put_char(input_buffer, keyboard, keycode);
+        break;
+      }
+    case XKB_KEY_Tab:
+    case XKB_KEY_Down:
+      select_next(mode);
+      update_list(mode);
+      goto done;
+
+    case XKB_KEY_p:
+      if (!ctrl) {
+        put_char(input_buffer, keyboard, keycode);
+        break;
+      }
+    case XKB_KEY_ISO_Left_Tab:
+    case XKB_KEY_Up:
+      select_prev(mode);
+      update_list(mode);
+      goto done;
+
+    case XKB_KEY_c:
+    case XKB_KEY_d:
+      if (!ctrl) {
+        put_char(input_buffer, keyboard, keycode);
+        break;
+      }
+    case XKB_KEY_Escape:
+      hikari_server_enter_normal_mode(NULL);
+      goto done;
+
+    case XKB_KEY_Return:
+      confirm_find();
+      goto done;
+
+    default:
+      put_char(input_buffer, keyboard, keycode);
+      break;
+  }
+
+  mode->selected = 0;
+  search(mode);
+  update_list(mode);
+
+done:
+  return;
+}
+
+static void
+key_handler(
+    struct hikari_keyboard *keyboard, struct wlr_event_keyboard_key *event)
+{
+  if (event->state == WL_KEYBOARD_KEY_STATE_PRESSED) {
+    uint32_t keycode = event->keycode + 8;
+    hikari_keyboard_for_keysym(keyboard, keycode, handle_keysym);
+  }
+}
+
+static void
+modifiers_handler(struct hikari_keyboard *keyboard)
+{}
+
+static void
+cancel(void)
+{
+  struct hikari_find_mode *mode = get_mode();
+
+  damage_list(mode);
+
+  hikari_indicator_bar_fini(&mode->prompt);
+  for (int i = 0; i < HIKARI_FIND_MODE_MAX_RESULTS; i++) {
+    hikari_indicator_bar_fini(&mode->entries[i]);
+  }
+
+  hikari_input_buffer_clear(&mode->input_buffer);
+  mode->nr_of_results = 0;
+  mode->selected = 0;
+}
+
+static void
+button_handler(
+    struct hikari_cursor *cursor, struct wlr_event_pointer_button *event)
+{}
+
+static void
+cursor_move(uint32_t time_msec)
+{}
+
+void
+hikari_find_mode_init(struct hikari_find_mode *find_mode)
+{
+  find_mode->mode.key_handler = key_handler;
+  find_mode->mode.button_handler = button_handler;
+  find_mode->mode.modifiers_handler = modifiers_handler;
+  find_mode->mode.render = hikari_renderer_find_mode;
+  find_mode->mode.cancel = cancel;
+  find_mode->mode.cursor_move = cursor_move;
+  find_mode->nr_of_results = 0;
+  find_mode->selected = 0;
+  find_mode->generation = 0;
+}
+
+void
+hikari_find_mode_enter(void)
+{
+  struct hikari_find_mode *mode = &hikari_server.find_mode;
+  struct hikari_indicator *indicator = &hikari_server.indicator;
+  int bar_height = hikari_configuration->font.height + 5;
+
+  hikari_indicator_bar_init(
+      &mode->prompt, indicator, 0, hikari_configuration->indicator_insert);
+
+  for (int i = 0; i < HIKARI_FIND_MODE_MAX_RESULTS; i++) {
+    hikari_indicator_bar_init(&mode->entries[i],
+        indicator,
+        (i + 1) * bar_height,
+        hikari_configuration->indicator_grouped);
+  }
+
+  hikari_server.mode = (struct hikari_mode *)mode;
+
+  hikari_input_buffer_clear(&mode->input_buffer);
+
+  mode->selected = 0;
+  search(mode);
+  update_list(mode);
+}
+
+void
+hikari_find_mode_origin(struct hikari_output *output, struct wlr_box *origin)
+{
+  struct wlr_box *usable_area = &output->usable_area;
+
+  origin->x = usable_area->x + usable_area->width / 4;
+  origin->y = usable_area->y + usable_area->height / 4;
+  origin->width = 0;
+  origin->height = 0;
+}
@@ -4,7 +4,9 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <hikari/group_trie.h>
 #include <hikari/memory.h>
+#include <hikari/server.h>
 #include <hikari/view.h>
 
 void
@@ -19,11 +21,15 @@ hikari_group_init(struct hikari_group *group, const char *name)
   wl_list_init(&group->visible_views);
 
   wl_list_insert(&hikari_server.groups, &group->server_groups);
+
+  hikari_group_trie_insert(&hikari_server.group_trie, group);
 }
 
 void
 hikari_group_fini(struct hikari_group *group)
 {
+  hikari_group_trie_remove(&hikari_server.group_trie, group);
+
   hikari_free(group->name);
   wl_list_remove(&group->server_groups);
 }
@@ -13,7 +13,6 @@
 #include <hikari/indicator.h>
 #include <hikari/indicator_frame.h>
 #include <hikari/keyboard.h>
-#include <hikari/memory.h>
 #include <hikari/normal_mode.h>
 #include <hikari/renderer.h>
 #include <hikari/server.h>
@@ -36,27 +35,15 @@ init_completion(void)
 {
   struct hikari_group_assign_mode *mode = get_mode();
 
-  if (mode->completion != NULL) {
+  if (mode->completing) {
     return;
   }
 
-  struct hikari_group *group;
-  struct hikari_completion *completion =
-      hikari_malloc(sizeof(struct hikari_completion));
-
-  char *input = mode->input_buffer.buffer;
+  hikari_completion_init(&mode->completion,
+      &hikari_server.group_trie,
+      mode->input_buffer.buffer);
 
-  hikari_completion_init(completion, input);
-
-  wl_list_for_each (group, &hikari_server.groups, server_groups) {
-    char *name = group->name;
-
-    if (strstr(name, input) == name && strcmp(name, input) != 0) {
-      hikari_completion_add(completion, name);
-    }
-  }
-
-  mode->completion = completion;
+  mode->completing = true;
 }
 
 static void
@@ -64,13 +51,7 @@ fini_completion(void)
 {
   struct hikari_group_assign_mode *mode = get_mode();
 
-  if (mode->completion == NULL) {
-    return;
-  }
-
-  hikari_completion_fini(mode->completion);
-  hikari_free(mode->completion);
-  mode->completion = NULL;
+  mode->completing = false;
 }
 
 static void
@@ -170,8 +151,8 @@ handle_keysym(
 
     case XKB_KEY_e:
       if (hikari_keyboard_check_modifier(keyboard, WLR_MODIFIER_CTRL)) {
-        if (mode->completion != NULL) {
-          text = hikari_completion_cancel(mode->completion);
+        if (mode->completing) {
+          text = hikari_completion_cancel(&mode->completion);
           hikari_input_buffer_replace(input_buffer, text);
           fini_completion();
         }
@@ -214,13 +195,13 @@ handle_keysym(
 
     case XKB_KEY_Tab:
       init_completion();
-      text = hikari_completion_next(mode->completion);
+      text = hikari_completion_next(&mode->completion);
       hikari_input_buffer_replace(input_buffer, text);
       break;
 
     case XKB_KEY_ISO_Left_Tab:
       init_completion();
-      text = hikari_completion_prev(mode->completion);
+      text = hikari_completion_prev(&mode->completion);
       hikari_input_buffer_replace(input_buffer, text);
       break;
 
@@ -314,7 +295,7 @@ hikari_group_assign_mode_init(
   group_assign_mode->mode.cancel = cancel;
   group_assign_mode->mode.cursor_move = cursor_move;
   group_assign_mode->group = NULL;
-  group_assign_mode->completion = NULL;
+  group_assign_mode->completing = false;
 }
 
 void
@@ -0,0 +1,201 @@
+#include <hikari/group_trie.h>
+
+#include <assert.h>
+#include <stddef.h>
+
+#include <hikari/group.h>
+#include <hikari/slab.h>
+
+static void
+init_node(struct hikari_group_trie_node *node,
+    struct hikari_group_trie_node *parent,
+    unsigned char key)
+{
+  node->group = NULL;
+  node->parent = parent;
+  node->children = NULL;
+  node->next = NULL;
+  node->key = key;
+}
+
+static void
+free_children(struct hikari_group_trie_node *node)
+{
+  struct hikari_group_trie_node *child = node->children;
+
+  while (child != NULL) {
+    struct hikari_group_trie_node *next = child->next;
+
+    free_children(child);
+    hikari_slab_free(&hikari_group_trie_node_slab, child);
+
+    child = next;
+  }
+
+  node->children = NULL;
+}
+
+static struct hikari_group_trie_node *
+find_child(struct hikari_group_trie_node *node, unsigned char key)
+{
+  struct hikari_group_trie_node *child = node->children;
+
+  while (child != NULL && child->key < key) {
+    child = child->next;
+  }
+
+  if (child != NULL && child->key == key) {
+    return child;
+  }
+
+  return NULL;
+}
+
+static struct hikari_group_trie_node *
+last_descendant(struct hikari_group_trie_node *node)
+{
+  while (node->children != NULL) {
+    node = node->children;
+
+    while (node->next != NULL) {
+      node = node->next;
+    }
+  }
+
+  return node;
+}
+
+void
+hikari_group_trie_init(struct hikari_group_trie *trie)
+{
+  init_node(&trie->root, NULL, '\0');
+  trie->generation = 0;
+}
+
+void
+hikari_group_trie_fini(struct hikari_group_trie *trie)
+{
+  free_children(&trie->root);
+}
+
+void
+hikari_group_trie_insert(
+    struct hikari_group_trie *trie, struct hikari_group *group)
+{
+  struct hikari_group_trie_node *node = &trie->root;
+
+  for (const char *c = group->name; *c != '\0'; c++) {
+    unsigned char key = *c;
+    struct hikari_group_trie_node **link = &node->children;
+
+    while (*link != NULL && (*link)->key < key) {
+      link = &(*link)->next;
+    }
+
+    if (*link == NULL || (*link)->key != key) {
+      struct hikari_group_trie_node *child =
+          hikari_slab_alloc(&hikari_group_trie_node_slab);
+
+      init_node(child, node, key);
+      child->next = *link;
+      *link = child;
+    }
+
+    node = *link;
+  }
+
+  assert(node->group == NULL);
+
+  node->group = group;
+}
+
+void
+hikari_group_trie_remove(
+    struct hikari_group_trie *trie, struct hikari_group *group)
+{
+  struct hikari_group_trie_node *node =
+      hikari_group_trie_lookup(trie, group->name);
+
+  assert(node != NULL);
+  assert(node->group == group);
+
+  node->group = NULL;
+
+  while (node != &trie->root && node->group == NULL &&
+         node->children == NULL) {
+    struct hikari_group_trie_node *parent = node->parent;
+    struct hikari_group_trie_node **link = &parent->children;
+
+    while (*link != node) {
+      link = &(*link)->next;
+    }
+
+    *link = node->next;
+    hikari_slab_free(&hikari_group_trie_node_slab, node);
+
+    node = parent;
+  }
+
+  trie->generation++;
+}
+
+struct hikari_group_trie_node *
+hikari_group_trie_lookup(struct hikari_group_trie *trie, const char *prefix)
+{
+  struct hikari_group_trie_node *node = &trie->root;
+
+  for (const char *c = prefix; *c != '\0' && node != NULL; c++) {
+    node = find_child(node, *c);
+  }
+
+  return node;
+}
+
+struct hikari_group_trie_node *
+hikari_group_trie_next(struct hikari_group_trie_node *node,
+    struct hikari_group_trie_node *root)
+{
+  if (node == NULL) {
+    return root;
+  }
+
+  if (node->children != NULL) {
+    return node->children;
+  }
+
+  while (node != root) {
+    if (node->next != NULL) {
+      return node->next;
+    }
+
+    node = node->parent;
+  }
+
+  return NULL;
+}
+
+struct hikari_group_trie_node *
+hikari_group_trie_prev(struct hikari_group_trie_node *node,
+    struct hikari_group_trie_node *root)
+{
+  if (node == NULL) {
+    return last_descendant(root);
+  }
+
+  if (node == root) {
+    return NULL;
+  }
+
+  struct hikari_group_trie_node *parent = node->parent;
+  struct hikari_group_trie_node *sibling = parent->children;
+
+  if (sibling == node) {
+    return parent;
+  }
+
+  while (sibling->next != node) {
+    sibling = sibling->next;
+  }
+
+  return last_descendant(sibling);
+}
@@ -0,0 +1,199 @@
+#include <hikari/idle.h>
+
+#include <wlr/types/wlr_idle.h>
+#include <wlr/types/wlr_idle_inhibit_v1.h>
+
+#include <hikari/configuration.h>
+#include <hikari/lock_mode.h>
+#include <hikari/memory.h>
+#include <hikari/output.h>
+#include <hikari/server.h>
+
+struct hikari_idle_inhibitor {
+  struct hikari_idle *idle;
+
+  struct wl_listener destroy;
+};
+
+static int
+elapsed_msec(struct hikari_idle *idle)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  return (now.tv_sec - idle->last_activity.tv_sec) * 1000 +
+         (now.tv_nsec - idle->last_activity.tv_nsec) / 1000000L;
+}
+
+static void
+arm_timer(struct hikari_idle *idle)
+{
+  int standby = hikari_configuration->idle_standby * 1000;
+  int power_off = hikari_configuration->idle_power_off * 1000;
+  int timeout = 0;
+
+  if (idle->inhibitors == 0) {
+    switch (idle->state) {
+      case HIKARI_IDLE_STATE_ACTIVE:
+        timeout = standby > 0 ? standby : power_off;
+        break;
+
+      case HIKARI_IDLE_STATE_STANDBY:
+        timeout = power_off;
+        break;
+
+      case HIKARI_IDLE_STATE_POWER_OFF:
+        break;
+    }
+  }
+
+  if (timeout > 0) {
+    timeout -= elapsed_msec(idle);
+
+    if (timeout < 1) {
+      timeout = 1;
+    }
+  }
+
+  wl_event_source_timer_update(idle->timer, timeout);
+}
+
+static void
+wake(struct hikari_idle *idle)
+{
+  enum hikari_idle_state state = idle->state;
+
+  idle->state = HIKARI_IDLE_STATE_ACTIVE;
+
+  struct hikari_output *output;
+  wl_list_for_each (output, &hikari_server.outputs, server_outputs) {
+    if (state == HIKARI_IDLE_STATE_POWER_OFF &&
+        !hikari_lock_mode_are_outputs_disabled(&hikari_server.lock_mode)) {
+      hikari_output_enable(output);
+    }
+
+    hikari_output_damage_whole(output);
+  }
+}
+
+static int
+timer_handler(void *data)
+{
+  struct hikari_idle *idle = data;
+
+  int standby = hikari_configuration->idle_standby * 1000;
+  int power_off = hikari_configuration->idle_power_off * 1000;
+  int elapsed = elapsed_msec(idle);
+
+  if (idle->inhibitors > 0) {
+    return 0;
+  }
+
+  if (power_off > 0 && elapsed >= power_off) {
+    struct hikari_output *output;
+    wl_list_for_each (output, &hikari_server.outputs, server_outputs) {
+      hikari_output_disable(output);
+    }
+
+    idle->state = HIKARI_IDLE_STATE_POWER_OFF;
+  } else if (standby > 0 && elapsed >= standby) {
+    idle->state = HIKARI_IDLE_STATE_STANDBY;
+  }
+
+  arm_timer(idle);
+
+  return 0;
+}
+
+static void
+inhibitor_destroy_handler(struct wl_listener *listener, void *data)
+{
+  struct hikari_idle_inhibitor *inhibitor =
+      wl_container_of(listener, inhibitor, destroy);
+  struct hikari_idle *idle = inhibitor->idle;
+
+  wl_list_remove(&inhibitor->destroy.link);
+  hikari_free(inhibitor);
+
+  if (--idle->inhibitors == 0) {
+    wlr_idle_set_enabled(idle->wlr_idle, NULL, true);
+    clock_gettime(CLOCK_MONOTONIC, &idle->last_activity);
+    arm_timer(idle);
+  }
+}
+
+static void
+new_inhibitor_handler(struct wl_listener *listener, void *data)
+{
+  struct hikari_idle *idle = wl_container_of(listener, idle, new_inhibitor);
+  struct wlr_idle_inhibitor_v1 *wlr_inhibitor = data;
+
+  struct hikari_idle_inhibitor *inhibitor =
+      hikari_malloc(sizeof(struct hikari_idle_inhibitor));
+
+  inhibitor->idle = idle;
+  inhibitor->destroy.notify = inhibitor_destroy_handler;
+  wl_signal_add(&wlr_inhibitor->events.destroy, &inhibitor->destroy);
+
+  if (idle->inhibitors++ == 0) {
+    wlr_idle_set_enabled(idle->wlr_idle, NULL, false);
+
+    if (hikari_idle_is_standby(idle)) {
+      wake(idle);
+    }
+
+    arm_timer(idle);
+  }
+}
+
+void
+hikari_idle_init(struct hikari_idle *idle,
+    struct wl_display *display,
+    struct wl_event_loop *event_loop)
+{
+  idle->wlr_idle = wlr_idle_create(display);
+  idle->inhibit_manager = wlr_idle_inhibit_v1_create(display);
+
+  idle->timer = wl_event_loop_add_timer(event_loop, timer_handler, idle);
+  idle->state = HIKARI_IDLE_STATE_ACTIVE;
+  idle->inhibitors = 0;
+  clock_gettime(CLOCK_MONOTONIC, &idle->last_activity);
+
+  idle->new_inhibitor.notify = new_inhibitor_handler;
+  wl_signal_add(
+      &idle->inhibit_manager->events.new_inhibitor, &idle->new_inhibitor);
+
+  arm_timer(idle);
+}
+
+void
+hikari_idle_fini(struct hikari_idle *idle)
+{
+  wl_list_remove(&idle->new_inhibitor.link);
+
+  wl_event_source_remove(idle->timer);
+}
+
+void
+hikari_idle_configure(struct hikari_idle *idle)
+{
+  if (hikari_idle_is_standby(idle)) {
+    wake(idle);
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &idle->last_activity);
+  arm_timer(idle);
+}
+
+void
+hikari_idle_notify_activity(struct hikari_idle *idle)
+{
+  clock_gettime(CLOCK_MONOTONIC, &idle->last_activity);
+
+  wlr_idle_notify_activity(idle->wlr_idle, hikari_server.seat);
+
+  if (hikari_idle_is_standby(idle)) {
+    wake(idle);
+    arm_timer(idle);
+  }
+}
@@ -14,6 +14,7 @@
 #include <hikari/configuration.h>
 #include <hikari/font.h>
 #include <hikari/indicator.h>
+#include <hikari/memory.h>
 #include <hikari/output.h>
 #include <hikari/renderer.h>
 #include <hikari/server.h>
@@ -27,19 +28,31 @@ hikari_indicator_bar_init(struct hikari_indicator_bar *indicator_bar,
 {
   indicator_bar->texture = NULL;
   indicator_bar->indicator = indicator;
+  indicator_bar->text = NULL;
+  indicator_bar->dirty = false;
+  indicator_bar->width = 0;
   indicator_bar->offset = offset;
 
-  hikari_indicator_bar_set_color(indicator_bar, color);
+  indicator_bar->color[0] = color[0];
+  indicator_bar->color[1] = color[1];
+  indicator_bar->color[2] = color[2];
+  indicator_bar->color[3] = color[3];
 }
 
 void
 hikari_indicator_bar_set_color(
     struct hikari_indicator_bar *indicator_bar, float color[static 4])
 {
+  if (!memcmp(indicator_bar->color, color, sizeof(indicator_bar->color))) {
+    return;
+  }
+
   indicator_bar->color[0] = color[0];
   indicator_bar->color[1] = color[1];
   indicator_bar->color[2] = color[2];
   indicator_bar->color[3] = color[3];
+
+  indicator_bar->dirty = true;
 }
 
 void
@@ -47,6 +60,9 @@ hikari_indicator_bar_fini(struct hikari_indicator_bar *indicator_bar)
 {
   wlr_texture_destroy(indicator_bar->texture);
   indicator_bar->texture = NULL;
+
+  hikari_free(indicator_bar->text);
+  indicator_bar->text = NULL;
 }
 
 void
@@ -67,22 +83,49 @@ hikari_indicator_bar_update(struct hikari_indicator_bar *indicator_bar,
     struct hikari_output *output,
     const char *text)
 {
-  if (indicator_bar->texture != NULL) {
-    hikari_indicator_bar_fini(indicator_bar);
+  if (text == NULL || !strcmp(text, "")) {
+    if (indicator_bar->text != NULL) {
+      hikari_free(indicator_bar->text);
+      indicator_bar->text = NULL;
+      indicator_bar->dirty = true;
+    }
+    return;
   }
 
-  if (text == NULL || !strcmp(text, "")) {
+  if (indicator_bar->text != NULL && !strcmp(indicator_bar->text, text)) {
     return;
   }
 
   size_t len = strlen(text);
 
+  hikari_free(indicator_bar->text);
+  indicator_bar->text = hikari_malloc(len + 1);
+  strcpy(indicator_bar->text, text);
+
+  indicator_bar->width = hikari_configuration->font.character_width * len + 8;
+  indicator_bar->dirty = true;
+}
+
+void
+hikari_indicator_bar_refresh(struct hikari_indicator_bar *indicator_bar,
+    struct wlr_renderer *wlr_renderer)
+{
+  if (!indicator_bar->dirty) {
+    return;
+  }
+
+  indicator_bar->dirty = false;
+
+  wlr_texture_destroy(indicator_bar->texture);
+  indicator_bar->texture = NULL;
+
+  if (indicator_bar->text == NULL) {
+    return;
+  }
+
   struct hikari_font *font = &hikari_configuration->font;
-  int width = hikari_configuration->font.character_width * len + 8;
+  int width = indicator_bar->width;
   int height = hikari_configuration->font.height;
-  struct wlr_renderer *wlr_renderer = output->wlr_output->renderer;
-
-  indicator_bar->width = width;
 
   cairo_surface_t *surface =
       cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
@@ -109,7 +152,7 @@ hikari_indicator_bar_update(struct hikari_indicator_bar *indicator_bar,
   cairo_set_source_rgba(cairo, 0, 0, 0, 1);
   pango_layout_set_font_description(layout, font->desc);
   cairo_move_to(cairo, 4, 4);
-  pango_layout_set_text(layout, text, -1);
+  pango_layout_set_text(layout, indicator_bar->text, -1);
 
   pango_cairo_update_layout(cairo, layout);
   pango_cairo_show_layout(cairo, layout);
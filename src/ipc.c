@@ -0,0 +1,733 @@
+#include <hikari/ipc.h>
+
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <wlr/types/wlr_output.h>
+
+#include <hikari/action.h>
+#include <hikari/configuration.h>
+#include <hikari/group.h>
+#include <hikari/mark.h>
+#include <hikari/memory.h>
+#include <hikari/output.h>
+#include <hikari/server.h>
+#include <hikari/sheet.h>
+#include <hikari/slab.h>
+#include <hikari/trace.h>
+#include <hikari/view.h>
+#include <hikari/workspace.h>
+
+static void
+buffer_reserve(struct hikari_ipc_buffer *buffer, size_t len)
+{
+  if (buffer->len + len <= buffer->size) {
+    return;
+  }
+
+  size_t size = buffer->size == 0 ? 4096 : buffer->size;
+  while (size < buffer->len + len) {
+    size *= 2;
+  }
+
+  char *data = hikari_malloc(size);
+  if (buffer->data != NULL) {
+    memcpy(data, buffer->data, buffer->len);
+    hikari_free(buffer->data);
+  }
+
+  buffer->data = data;
+  buffer->size = size;
+}
+
+static void
+buffer_consume(struct hikari_ipc_buffer *buffer, size_t len)
+{
+  memmove(buffer->data, buffer->data + len, buffer->len - len);
+  buffer->len -= len;
+}
+
+static bool
+client_has_room(struct hikari_ipc_client *client, size_t len)
+{
+  if (client->out.len + len > HIKARI_IPC_MAX_PENDING) {
+    client->disconnect = true;
+  }
+
+  return !client->disconnect;
+}
+
+static void
+client_printf(struct hikari_ipc_client *client, const char *fmt, ...)
+{
+  va_list args;
+
+  va_start(args, fmt);
+  int len = vsnprintf(NULL, 0, fmt, args);
+  va_end(args);
+
+  if (len < 0 || !client_has_room(client, len + 1)) {
+    return;
+  }
+
+  buffer_reserve(&client->out, len + 1);
+
+  va_start(args, fmt);
+  vsnprintf(client->out.data + client->out.len, len + 1, fmt, args);
+  va_end(args);
+
+  client->out.len += len;
+}
+
+static void
+client_write_field(struct hikari_ipc_client *client, const char *str)
+{
+  if (str == NULL || *str == '\0') {
+    str = "-";
+  }
+
+  size_t len = strlen(str);
+  if (!client_has_room(client, len + 1)) {
+    return;
+  }
+
+  buffer_reserve(&client->out, len + 1);
+
+  char *data = client->out.data + client->out.len;
+  for (size_t i = 0; i < len; i++) {
+    data[i] = str[i] == '\t' || str[i] == '\n' ? ' ' : str[i];
+  }
+  data[len] = '\t';
+
+  client->out.len += len + 1;
+}
+
+static void
+client_end_line(struct hikari_ipc_client *client)
+{
+  if (client->out.len > 0 && client->out.data[client->out.len - 1] == '\t') {
+    client->out.data[client->out.len - 1] = '\n';
+  } else {
+    client_printf(client, "\n");
+  }
+}
+
+static void
+flush_client(struct hikari_ipc_client *client)
+{
+  while (client->out.len > 0 && !client->disconnect) {
+    ssize_t ret = send(client->fd,
+        client->out.data,
+        client->out.len,
+        MSG_NOSIGNAL | MSG_DONTWAIT);
+
+    if (ret == -1) {
+      if (errno == EINTR) {
+        continue;
+      } else if (errno == EAGAIN) {
+        break;
+      }
+
+      client->disconnect = true;
+      break;
+    }
+
+    buffer_consume(&client->out, ret);
+  }
+
+  uint32_t mask = client->closing ? 0 : WL_EVENT_READABLE;
+  if (client->out.len > 0 || client->disconnect) {
+    mask |= WL_EVENT_WRITABLE;
+  }
+  wl_event_source_fd_update(client->event_source, mask);
+}
+
+static void
+destroy_client(struct hikari_ipc_client *client)
+{
+  wl_list_remove(&client->link);
+  wl_event_source_remove(client->event_source);
+  close(client->fd);
+
+  hikari_free(client->in.data);
+  hikari_free(client->out.data);
+  hikari_free(client);
+}
+
+static void
+write_view_id(struct hikari_ipc_client *client, struct hikari_view *view)
+{
+  if (view == NULL) {
+    client_write_field(client, NULL);
+  } else {
+    client_printf(client, "%" PRIu32 "\t", view->serial);
+  }
+}
+
+static void
+write_view(struct hikari_ipc_client *client, struct hikari_view *view)
+{
+  char flags[8];
+  int n = 0;
+
+  if (view == hikari_server.workspace->focus_view) {
+    flags[n++] = 'f';
+  }
+  if (hikari_view_is_hidden(view)) {
+    flags[n++] = 'h';
+  }
+  if (hikari_view_is_invisible(view)) {
+    flags[n++] = 'i';
+  }
+  if (hikari_view_is_floating(view)) {
+    flags[n++] = 'l';
+  }
+  if (hikari_view_is_public(view)) {
+    flags[n++] = 'p';
+  }
+  if (hikari_view_is_tiled(view)) {
+    flags[n++] = 't';
+  }
+  flags[n] = '\0';
+
+  client_write_field(client, "view");
+  write_view_id(client, view);
+  client_write_field(client, view->output->wlr_output->name);
+  client_printf(client, "%d\t", view->sheet->nr);
+  client_write_field(client, view->group != NULL ? view->group->name : NULL);
+  client_write_field(client, view->mark != NULL ? view->mark->name : NULL);
+  client_printf(client,
+      "%d\t%d\t%d\t%d\t",
+      view->geometry.x,
+      view->geometry.y,
+      view->geometry.width,
+      view->geometry.height);
+  client_write_field(client, flags);
+  client_write_field(client, view->id);
+  client_write_field(client, view->title);
+  client_end_line(client);
+}
+
+static void
+query_views(struct hikari_ipc_client *client)
+{
+  struct hikari_output *output;
+  wl_list_for_each (output, &hikari_server.outputs, server_outputs) {
+    struct hikari_view *view;
+    wl_list_for_each (view, &output->views, output_views) {
+      write_view(client, view);
+    }
+  }
+}
+
+static void
+query_groups(struct hikari_ipc_client *client)
+{
+  struct hikari_group *group;
+  wl_list_for_each (group, &hikari_server.groups, server_groups) {
+    client_write_field(client, "group");
+    client_write_field(client, group->name);
+    client_printf(client, "%d\n", wl_list_length(&group->views));
+  }
+}
+
+static void
+query_sheets(struct hikari_ipc_client *client)
+{
+  struct hikari_output *output;
+  wl_list_for_each (output, &hikari_server.outputs, server_outputs) {
+    struct hikari_workspace *workspace = output->workspace;
+
+    for (int i = 0; i < HIKARI_NR_OF_SHEETS; i++) {
+      struct hikari_sheet *sheet = &workspace->sheets[i];
+      const char *flags = sheet == workspace->sheet
+                              ? "c"
+                              : sheet == workspace->alternate_sheet ? "a" : "-";
+
+      client_write_field(client, "sheet");
+      client_write_field(client, output->wlr_output->name);
+      client_printf(client,
+          "%d\t%d\t%s\n",
+          sheet->nr,
+          wl_list_length(&sheet->views),
+          flags);
+    }
+  }
+}
+
+static void
+query_marks(struct hikari_ipc_client *client)
+{
+  for (int i = 0; i < HIKARI_NR_OF_MARKS; i++) {
+    struct hikari_mark *mark = &hikari_marks[i];
+
+    client_write_field(client, "mark");
+    client_write_field(client, mark->name);
+    write_view_id(client, mark->view);
+    client_end_line(client);
+  }
+}
+
+static void
+query_outputs(struct hikari_ipc_client *client)
+{
+  struct hikari_output *output;
+  wl_list_for_each (output, &hikari_server.outputs, server_outputs) {
+    client_write_field(client, "output");
+    client_write_field(client, output->wlr_output->name);
+    client_printf(client,
+        "%d\t%d\t%d\t%d\t%s\t%lu\t%lu\n",
+        output->geometry.x,
+        output->geometry.y,
+        output->geometry.width,
+        output->geometry.height,
+        hikari_server.workspace == output->workspace ? "f" : "-",
+        output->cursor_stats.hardware,
+        output->cursor_stats.software);
+  }
+}
+
+static unsigned long
+region_area(pixman_region32_t *region)
+{
+  unsigned long area = 0;
+  int nrects;
+  pixman_box32_t *rects = pixman_region32_rectangles(region, &nrects);
+
+  for (int i = 0; i < nrects; i++) {
+    area += (unsigned long)(rects[i].x2 - rects[i].x1) *
+            (rects[i].y2 - rects[i].y1);
+  }
+
+  return area;
+}
+
+static void
+query_damage(struct hikari_ipc_client *client)
+{
+  struct hikari_output *output;
+  wl_list_for_each (output, &hikari_server.outputs, server_outputs) {
+    struct hikari_damage_ring *damage_ring = &output->damage_ring;
+    struct hikari_damage_ring_stats *stats = &damage_ring->stats;
+
+    client_write_field(client, "damage");
+    client_write_field(client, output->wlr_output->name);
+    client_printf(client,
+        "%lu\t%lu\t%lu\t%lu\t%lu\n",
+        stats->frames,
+        stats->full,
+        stats->unknown_age,
+        stats->validated,
+        stats->mismatches);
+
+    for (int i = 1; i <= damage_ring->nr_of_frames; i++) {
+      int index = (damage_ring->head - i + HIKARI_DAMAGE_RING_SIZE) %
+                  HIKARI_DAMAGE_RING_SIZE;
+      struct hikari_damage_ring_frame *frame = &damage_ring->frames[index];
+
+      client_write_field(client, "frame");
+      client_write_field(client, output->wlr_output->name);
+      client_printf(client,
+          "%d\t%s\t%lu\n",
+          frame->buffer_age,
+          frame->full ? "f" : "-",
+          region_area(&frame->damage));
+    }
+  }
+}
+
+static void
+write_slab(struct hikari_slab *slab, void *data)
+{
+  struct hikari_ipc_client *client = data;
+
+  client_write_field(client, "slab");
+  client_write_field(client, slab->name);
+  client_printf(client,
+      "%zu\t%zu\t%zu\t%zu\n",
+      slab->size,
+      slab->nr_of_objects,
+      slab->peak,
+      slab->nr_of_chunks);
+}
+
+static void
+query_memory(struct hikari_ipc_client *client)
+{
+  hikari_slab_for_each(write_slab, client);
+}
+
+static struct hikari_view *
+find_view(const char *id)
+{
+  char *end;
+  unsigned long serial = strtoul(id, &end, 10);
+
+  if (!isdigit((unsigned char)*id) || *end != '\0' || serial > UINT32_MAX) {
+    return NULL;
+  }
+
+  struct hikari_view *view =
+      hikari_view_table_lookup(&hikari_server.view_table, serial);
+
+  // views keep their serial while unmapped, but have no sheet or surface then
+  if (view == NULL || !hikari_view_is_mapped(view)) {
+    return NULL;
+  }
+
+  return view;
+}
+
+static const char *
+focus_view(const char *id)
+{
+  struct hikari_view *view = find_view(id);
+
+  if (view == NULL) {
+    return "unknown view";
+  }
+
+  if (view->sheet->workspace->sheet != view->sheet && view->sheet->nr != 0) {
+    hikari_workspace_switch_sheet(view->sheet->workspace, view->sheet);
+  }
+
+  if (hikari_view_is_hidden(view)) {
+    hikari_view_show(view);
+  } else {
+    hikari_view_raise(view);
+  }
+
+  hikari_view_center_cursor(view);
+  hikari_server_cursor_focus();
+
+  return NULL;
+}
+
+static const char *
+execute_action(const char *action_name)
+{
+  struct hikari_event_action event_action;
+
+  if (!hikari_action_resolve(
+          &event_action, &hikari_configuration->action_configs, action_name)) {
+    return "unknown action";
+  }
+
+  event_action.action(event_action.arg);
+
+  return NULL;
+}
+
+static uint32_t
+parse_event(const char *event_name)
+{
+  if (!strcmp(event_name, "focus")) {
+    return HIKARI_IPC_EVENT_FOCUS;
+  } else if (!strcmp(event_name, "map")) {
+    return HIKARI_IPC_EVENT_MAP;
+  } else if (!strcmp(event_name, "sheet")) {
+    return HIKARI_IPC_EVENT_SHEET;
+  }
+
+  return 0;
+}
+
+static const char *
+handle_request(struct hikari_ipc_client *client, char *request)
+{
+  char *argument = strchr(request, ' ');
+  if (argument != NULL) {
+    *argument++ = '\0';
+  }
+
+  if (!strcmp(request, "subscribe") || !strcmp(request, "unsubscribe")) {
+    uint32_t event = argument != NULL ? parse_event(argument) : 0;
+
+    if (event == 0) {
+      return "unknown event";
+    }
+
+    if (request[0] == 's') {
+      client->subscriptions |= event;
+    } else {
+      client->subscriptions &= ~event;
+    }
+
+    return NULL;
+  }
+
+  if (hikari_server_in_lock_mode()) {
+    return "locked";
+  }
+
+  if (!strcmp(request, "views")) {
+    query_views(client);
+  } else if (!strcmp(request, "groups")) {
+    query_groups(client);
+  } else if (!strcmp(request, "sheets")) {
+    query_sheets(client);
+  } else if (!strcmp(request, "marks")) {
+    query_marks(client);
+  } else if (!strcmp(request, "outputs")) {
+    query_outputs(client);
+  } else if (!strcmp(request, "damage")) {
+    query_damage(client);
+  } else if (!strcmp(request, "memory")) {
+    query_memory(client);
+#ifdef HAVE_TRACE
+  } else if (!strcmp(request, "trace")) {
+    const char *path = hikari_trace_dump();
+
+    if (path == NULL) {
+      return "could not write trace";
+    }
+
+    client_write_field(client, path);
+    client_end_line(client);
+#endif
+  } else if (!strcmp(request, "action") || !strcmp(request, "focus")) {
+    if (argument == NULL) {
+      return "missing argument";
+    }
+
+    if (!hikari_server_in_normal_mode()) {
+      return "busy";
+    }
+
+    return request[0] == 'a' ? execute_action(argument) : focus_view(argument);
+  } else {
+    return "unknown request";
+  }
+
+  return NULL;
+}
+
+static void
+read_requests(struct hikari_ipc_client *client)
+{
+  buffer_reserve(&client->in, HIKARI_IPC_MAX_REQUEST);
+
+  ssize_t ret = recv(client->fd,
+      client->in.data + client->in.len,
+      client->in.size - client->in.len,
+      0);
+
+  if (ret == 0) {
+    client->closing = true;
+    return;
+  } else if (ret == -1) {
+    if (errno != EAGAIN && errno != EINTR) {
+      client->disconnect = true;
+    }
+    return;
+  }
+
+  client->in.len += ret;
+
+  char *start = client->in.data;
+  char *end = client->in.data + client->in.len;
+  char *newline;
+
+  while ((newline = memchr(start, '\n', end - start)) != NULL) {
+    *newline = '\0';
+
+    const char *error = handle_request(client, start);
+    if (error != NULL) {
+      client_printf(client, "error\t%s\n", error);
+    } else {
+      client_printf(client, "ok\n");
+    }
+
+    start = newline + 1;
+  }
+
+  buffer_consume(&client->in, start - client->in.data);
+
+  if (client->in.len >= HIKARI_IPC_MAX_REQUEST) {
+    client->disconnect = true;
+  }
+}
+
+static int
+client_handler(int fd, uint32_t mask, void *data)
+{
+  struct hikari_ipc_client *client = data;
+
+  if (mask & (WL_EVENT_HANGUP | WL_EVENT_ERROR)) {
+    client->disconnect = true;
+  }
+
+  if (!client->disconnect && !client->closing && (mask & WL_EVENT_READABLE)) {
+    read_requests(client);
+  }
+
+  flush_client(client);
+
+  if (client->disconnect || (client->closing && client->out.len == 0)) {
+    destroy_client(client);
+  }
+
+  return 0;
+}
+
+static int
+accept_handler(int fd, uint32_t mask, void *data)
+{
+  struct hikari_ipc *ipc = data;
+
+  int client_fd = accept(fd, NULL, NULL);
+  if (client_fd == -1) {
+    return 0;
+  }
+
+  if (fcntl(client_fd, F_SETFD, FD_CLOEXEC) == -1 ||
+      fcntl(client_fd, F_SETFL, O_NONBLOCK) == -1) {
+    close(client_fd);
+    return 0;
+  }
+
+  struct hikari_ipc_client *client =
+      hikari_calloc(1, sizeof(struct hikari_ipc_client));
+
+  client->fd = client_fd;
+  client->event_source = wl_event_loop_add_fd(
+      ipc->event_loop, client_fd, WL_EVENT_READABLE, client_handler, client);
+
+  wl_list_insert(&ipc->clients, &client->link);
+
+  return 0;
+}
+
+static char *
+socket_path(const char *socket_name)
+{
+  const char *runtime_dir = getenv("XDG_RUNTIME_DIR");
+
+  if (runtime_dir == NULL) {
+    return NULL;
+  }
+
+  size_t len = strlen(runtime_dir) + strlen(socket_name) + 16;
+  char *ret = hikari_malloc(len);
+
+  snprintf(ret, len, "%s/hikari-%s.sock", runtime_dir, socket_name);
+
+  return ret;
+}
+
+void
+hikari_ipc_init(struct hikari_ipc *ipc,
+    struct wl_event_loop *event_loop,
+    const char *socket_name)
+{
+  struct sockaddr_un addr = { .sun_family = AF_UNIX };
+
+  wl_list_init(&ipc->clients);
+
+  ipc->fd = -1;
+  ipc->event_loop = event_loop;
+  ipc->event_source = NULL;
+  ipc->path = socket_path(socket_name);
+
+  if (ipc->path == NULL || strlen(ipc->path) >= sizeof(addr.sun_path)) {
+    goto error;
+  }
+  strcpy(addr.sun_path, ipc->path);
+
+  ipc->fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (ipc->fd == -1) {
+    goto error;
+  }
+
+  unlink(ipc->path);
+
+  if (fcntl(ipc->fd, F_SETFD, FD_CLOEXEC) == -1 ||
+      fcntl(ipc->fd, F_SETFL, O_NONBLOCK) == -1 ||
+      bind(ipc->fd, (struct sockaddr *)&addr, sizeof(addr)) == -1 ||
+      chmod(ipc->path, S_IRUSR | S_IWUSR) == -1 || listen(ipc->fd, 16) == -1) {
+    goto error;
+  }
+
+  ipc->event_source = wl_event_loop_add_fd(
+      event_loop, ipc->fd, WL_EVENT_READABLE, accept_handler, ipc);
+
+  setenv("HIKARI_SOCKET", ipc->path, true);
+
+  return;
+
+error:
+  fprintf(stderr, "could not create ipc socket\n");
+
+  if (ipc->fd != -1) {
+    close(ipc->fd);
+    ipc->fd = -1;
+  }
+}
+
+void
+hikari_ipc_fini(struct hikari_ipc *ipc)
+{
+  struct hikari_ipc_client *client, *client_temp;
+  wl_list_for_each_safe (client, client_temp, &ipc->clients, link) {
+    destroy_client(client);
+  }
+
+  if (ipc->fd != -1) {
+    wl_event_source_remove(ipc->event_source);
+    close(ipc->fd);
+    unlink(ipc->path);
+  }
+
+  hikari_free(ipc->path);
+}
+
+void
+hikari_ipc_notify_focus(struct hikari_ipc *ipc, struct hikari_view *view)
+{
+  struct hikari_ipc_client *client;
+  wl_list_for_each (client, &ipc->clients, link) {
+    if (client->subscriptions & HIKARI_IPC_EVENT_FOCUS) {
+      client_printf(client, "event\tfocus\t");
+      write_view_id(client, view);
+      client_end_line(client);
+      flush_client(client);
+    }
+  }
+}
+
+void
+hikari_ipc_notify_map(struct hikari_ipc *ipc, struct hikari_view *view)
+{
+  struct hikari_ipc_client *client;
+  wl_list_for_each (client, &ipc->clients, link) {
+    if (client->subscriptions & HIKARI_IPC_EVENT_MAP) {
+      client_printf(client, "event\tmap\t");
+      write_view_id(client, view);
+      client_end_line(client);
+      flush_client(client);
+    }
+  }
+}
+
+void
+hikari_ipc_notify_sheet(struct hikari_ipc *ipc, struct hikari_sheet *sheet)
+{
+  struct hikari_ipc_client *client;
+  wl_list_for_each (client, &ipc->clients, link) {
+    if (client->subscriptions & HIKARI_IPC_EVENT_SHEET) {
+      client_printf(client, "event\tsheet\t");
+      client_write_field(client, sheet->workspace->output->wlr_output->name);
+      client_printf(client, "%d\n", sheet->nr);
+      flush_client(client);
+    }
+  }
+}
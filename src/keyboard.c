@@ -10,6 +10,7 @@
 #include <hikari/memory.h>
 #include <hikari/mode.h>
 #include <hikari/server.h>
+#include <hikari/trace.h>
 
 static void
 update_mod_state(struct hikari_keyboard *keyboard)
@@ -29,9 +30,19 @@ update_mod_state(struct hikari_keyboard *keyboard)
 static void
 key_handler(struct wl_listener *listener, void *data)
 {
+  HIKARI_TRACE_SCOPE("key");
+
   struct hikari_keyboard *keyboard = wl_container_of(listener, keyboard, key);
   struct wlr_event_keyboard_key *event = data;
 
+#ifdef HAVE_RECORD
+  hikari_recorder_key(&hikari_server.recorder, event);
+#endif
+
+#ifdef HAVE_IDLE
+  hikari_idle_notify_activity(&hikari_server.idle);
+#endif
+
   hikari_server.mode->key_handler(keyboard, event);
 }
 
@@ -59,31 +70,91 @@ destroy_handler(struct wl_listener *listener, void *data)
   /* wlr_seat_set_capabilities(hikari_server.seat, caps); */
 }
 
-struct keycode_matcher_state {
+struct keysym_entry {
   xkb_keysym_t keysym;
-  uint32_t *keycode;
+  xkb_keycode_t keycode;
+};
+
+struct keysym_table {
+  struct keysym_entry *entries;
+  size_t nr_of_entries;
   struct xkb_state *state;
 };
 
 static void
-match_keycode(struct xkb_keymap *keymap, xkb_keycode_t key, void *data)
+collect_keysym(struct xkb_keymap *keymap, xkb_keycode_t key, void *data)
 {
-  struct keycode_matcher_state *matcher_state = data;
-  xkb_keysym_t keysym = xkb_state_key_get_one_sym(matcher_state->state, key);
+  struct keysym_table *table = data;
+  xkb_keysym_t keysym = xkb_state_key_get_one_sym(table->state, key);
+
+  if (keysym != XKB_KEY_NoSymbol) {
+    struct keysym_entry *entry = &table->entries[table->nr_of_entries++];
 
-  if (keysym != XKB_KEY_NoSymbol && keysym == matcher_state->keysym &&
-      *(matcher_state->keycode) == 0) {
-    *(matcher_state->keycode) = key - 8;
+    entry->keysym = keysym;
+    entry->keycode = key;
   }
 }
 
+static int
+compare_keysym_entries(const void *a, const void *b)
+{
+  const struct keysym_entry *entry_a = a;
+  const struct keysym_entry *entry_b = b;
+
+  if (entry_a->keysym != entry_b->keysym) {
+    return entry_a->keysym < entry_b->keysym ? -1 : 1;
+  }
+
+  return entry_a->keycode < entry_b->keycode
+             ? -1
+             : entry_a->keycode > entry_b->keycode;
+}
+
 static void
-resolve_keysym(uint32_t *keycode, struct xkb_state *state, xkb_keysym_t keysym)
+keysym_table_init(struct keysym_table *table, struct xkb_keymap *keymap)
 {
-  struct keycode_matcher_state matcher_state = { keysym, keycode, state };
+  size_t nr_of_keys =
+      xkb_keymap_max_keycode(keymap) - xkb_keymap_min_keycode(keymap) + 1;
 
-  xkb_keymap_key_for_each(
-      xkb_state_get_keymap(state), match_keycode, &matcher_state);
+  table->entries = hikari_calloc(nr_of_keys, sizeof(struct keysym_entry));
+  table->nr_of_entries = 0;
+  table->state = xkb_state_new(keymap);
+
+  xkb_keymap_key_for_each(keymap, collect_keysym, table);
+
+  qsort(table->entries,
+      table->nr_of_entries,
+      sizeof(struct keysym_entry),
+      compare_keysym_entries);
+}
+
+static void
+keysym_table_fini(struct keysym_table *table)
+{
+  xkb_state_unref(table->state);
+  hikari_free(table->entries);
+}
+
+static void
+resolve_keysym(
+    uint32_t *keycode, struct keysym_table *table, xkb_keysym_t keysym)
+{
+  size_t low = 0;
+  size_t high = table->nr_of_entries;
+
+  while (low < high) {
+    size_t mid = low + (high - low) / 2;
+
+    if (table->entries[mid].keysym < keysym) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+
+  if (low < table->nr_of_entries && table->entries[low].keysym == keysym) {
+    *keycode = table->entries[low].keycode - 8;
+  }
 }
 
 static void
@@ -107,7 +178,8 @@ configure_bindings(struct hikari_keyboard *keyboard, struct wl_list *bindings)
     nr[mask] = 0;
   }
 
-  struct xkb_state *state = xkb_state_new(keyboard->keymap);
+  struct keysym_table table;
+  keysym_table_init(&table, keyboard->keymap);
 
   wl_list_for_each (binding_config, bindings, link) {
     uint8_t mask = binding_config->key.modifiers;
@@ -123,14 +195,14 @@ configure_bindings(struct hikari_keyboard *keyboard, struct wl_list *bindings)
 
       case HIKARI_ACTION_BINDING_KEY_KEYSYM:
         resolve_keysym(
-            &binding->keycode, state, binding_config->key.value.keysym);
+            &binding->keycode, &table, binding_config->key.value.keysym);
         break;
     }
 
     nr[mask]++;
   }
 
-  xkb_state_unref(state);
+  keysym_table_fini(&table);
 }
 
 void
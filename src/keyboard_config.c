@@ -4,6 +4,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <hikari/keymap_cache.h>
+
 #define HIKARI_KEYBOARD_CONFIG_DEFAULT_REPEAT_RATE 25
 #define HIKARI_KEYBOARD_CONFIG_DEFAULT_REPEAT_DELAY 600
 
@@ -84,6 +86,9 @@ done:
   return success;
 }
 
+static void
+xkb_fini(struct hikari_xkb_config *xkb_config);
+
 static bool
 load_xkb_file(struct hikari_xkb *xkb, const char *xkb_file)
 {
@@ -98,18 +103,20 @@ load_xkb_file(struct hikari_xkb *xkb, const char *xkb_file)
     goto done;
   }
 
-  struct xkb_context *context = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
-  struct xkb_keymap *keymap = xkb_keymap_new_from_file(context,
-      keymap_file,
-      XKB_KEYMAP_FORMAT_TEXT_V1,
-      XKB_KEYMAP_COMPILE_NO_FLAGS);
-  xkb_context_unref(context);
+  struct xkb_keymap *keymap = hikari_keymap_cache_load_file(keymap_file);
+  fclose(keymap_file);
 
   if (keymap == NULL) {
     goto done;
   }
 
-  xkb->type = HIKARI_XKB_TYPE_RULES;
+  if (xkb->type == HIKARI_XKB_TYPE_KEYMAP) {
+    xkb_keymap_unref(xkb->value.keymap);
+  } else {
+    xkb_fini(&xkb->value.rules);
+  }
+
+  xkb->type = HIKARI_XKB_TYPE_KEYMAP;
   xkb->value.keymap = keymap;
 
   success = true;
@@ -146,6 +153,9 @@ hikari_keyboard_config_parse(struct hikari_keyboard_config *keyboard_config,
             !load_xkb_file(&keyboard_config->xkb, xkb_file)) {
           goto done;
         }
+
+        free(keyboard_config->xkb_file);
+        keyboard_config->xkb_file = strdup(xkb_file);
       } else {
         fprintf(stderr,
             "configuration error: expected string or object for \"xkb\"\n");
@@ -207,6 +217,7 @@ hikari_keyboard_config_init(
   xkb_init(&keyboard_config->xkb.value.rules);
 
   keyboard_config->keyboard_name = strdup(keyboard_name);
+  keyboard_config->xkb_file = NULL;
 
   if (!strcmp(keyboard_name, "*")) {
     init_default_repeat(keyboard_config);
@@ -242,6 +253,7 @@ hikari_keyboard_config_fini(struct hikari_keyboard_config *keyboard_config)
   }
 
   free(keyboard_config->keyboard_name);
+  free(keyboard_config->xkb_file);
 }
 
 static void
@@ -286,6 +298,7 @@ hikari_keyboard_config_default(struct hikari_keyboard_config *keyboard_config)
 
   keyboard_config->keyboard_name = malloc(2 * sizeof(char));
   strcpy(keyboard_config->keyboard_name, "*");
+  keyboard_config->xkb_file = NULL;
 
   init_default_repeat(keyboard_config);
 }
@@ -349,12 +362,7 @@ compile_keymap(struct hikari_xkb_config *xkb_config)
   rules.variant = xkb_config->variant.value;
   rules.options = xkb_config->options.value;
 
-  struct xkb_context *context = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
-  struct xkb_keymap *keymap =
-      xkb_map_new_from_names(context, &rules, XKB_KEYMAP_COMPILE_NO_FLAGS);
-  xkb_context_unref(context);
-
-  return keymap;
+  return hikari_keymap_cache_compile(&rules);
 }
 
 bool
@@ -0,0 +1,304 @@
+#include <hikari/keymap_cache.h>
+
+#include <dirent.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include <hikari/config_cache.h>
+#include <hikari/memory.h>
+
+static struct xkb_context *context = NULL;
+static struct hikari_keymap_cache_entry entries[HIKARI_KEYMAP_CACHE_SIZE];
+static unsigned long uses = 0;
+static uint64_t data_hash = 0;
+static bool data_hashed = false;
+
+static struct xkb_context *
+get_context(void)
+{
+  if (context == NULL) {
+    context = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
+  }
+
+  return context;
+}
+
+static void
+rule_names_to_array(
+    const struct xkb_rule_names *rule_names, const char *names[static 5])
+{
+  names[0] = rule_names->rules;
+  names[1] = rule_names->model;
+  names[2] = rule_names->layout;
+  names[3] = rule_names->variant;
+  names[4] = rule_names->options;
+}
+
+static bool
+entry_matches(struct hikari_keymap_cache_entry *entry, const char *names[5])
+{
+  if (entry->keymap == NULL) {
+    return false;
+  }
+
+  for (int i = 0; i < 5; i++) {
+    if (entry->names[i] == NULL || names[i] == NULL) {
+      if (entry->names[i] != names[i]) {
+        return false;
+      }
+    } else if (strcmp(entry->names[i], names[i])) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static void
+entry_clear(struct hikari_keymap_cache_entry *entry)
+{
+  for (int i = 0; i < 5; i++) {
+    free(entry->names[i]);
+    entry->names[i] = NULL;
+  }
+
+  xkb_keymap_unref(entry->keymap);
+  entry->keymap = NULL;
+}
+
+static const char *default_names[5] = { "XKB_DEFAULT_RULES",
+  "XKB_DEFAULT_MODEL",
+  "XKB_DEFAULT_LAYOUT",
+  "XKB_DEFAULT_VARIANT",
+  "XKB_DEFAULT_OPTIONS" };
+
+// rules, symbols and the other components are looked up below the include
+// paths, vendor specific symbols live one level further down
+static uint64_t
+hash_tree(const char *path, int depth)
+{
+  struct stat st;
+
+  if (stat(path, &st) != 0) {
+    return 0;
+  }
+
+  uint64_t hash = hikari_config_cache_hash(&st.st_ino, sizeof(st.st_ino));
+  hash = hash * 31 + hikari_config_cache_hash(&st.st_size, sizeof(st.st_size));
+  hash = hash * 31 + hikari_config_cache_hash(&st.st_mtim, sizeof(st.st_mtim));
+
+  if (!S_ISDIR(st.st_mode) || depth == 0) {
+    return hash;
+  }
+
+  DIR *dir = opendir(path);
+
+  if (dir == NULL) {
+    return hash;
+  }
+
+  struct dirent *entry;
+  char child[PATH_MAX];
+
+  while ((entry = readdir(dir)) != NULL) {
+    if (!strcmp(entry->d_name, ".") || !strcmp(entry->d_name, "..")) {
+      continue;
+    }
+
+    int len = snprintf(child, sizeof(child), "%s/%s", path, entry->d_name);
+    if (len < 0 || (size_t)len >= sizeof(child)) {
+      continue;
+    }
+
+    // the order of directory entries is unspecified, so combine them in a
+    // way that does not depend on it
+    hash += hikari_config_cache_hash(entry->d_name, strlen(entry->d_name)) ^
+            hash_tree(child, depth - 1);
+  }
+
+  closedir(dir);
+
+  return hash;
+}
+
+static uint64_t
+hash_data(void)
+{
+  struct xkb_context *context = get_context();
+  unsigned int nr_of_include_paths = xkb_context_num_include_paths(context);
+  uint64_t hash = 0;
+
+  for (unsigned int i = 0; i < nr_of_include_paths; i++) {
+    const char *include_path = xkb_context_include_path_get(context, i);
+
+    hash = hash * 31 + hash_tree(include_path, 3);
+  }
+
+  return hash;
+}
+
+// walking the data directories is only worth it when a keymap is about to be
+// compiled, the hash is kept until the cache gets invalidated
+static uint64_t
+get_data_hash(void)
+{
+  if (!data_hashed) {
+    data_hash = hash_data();
+    data_hashed = true;
+  }
+
+  return data_hash;
+}
+
+static char *
+disk_cache_path(const char *names[5])
+{
+  uint64_t hash = get_data_hash();
+
+  for (int i = 0; i < 5; i++) {
+    const char *name = names[i] != NULL ? names[i] : getenv(default_names[i]);
+
+    if (name == NULL) {
+      name = "";
+    }
+
+    hash = hash * 31 + hikari_config_cache_hash(name, strlen(name) + 1);
+  }
+
+  char name[32];
+  snprintf(name, sizeof(name), "keymap-%016llx", (unsigned long long)hash);
+
+  return hikari_config_cache_file(name);
+}
+
+static struct xkb_keymap *
+load_disk_cache(const char *path)
+{
+  FILE *file = fopen(path, "r");
+
+  if (file == NULL) {
+    return NULL;
+  }
+
+  struct xkb_keymap *keymap = hikari_keymap_cache_load_file(file);
+  fclose(file);
+
+  return keymap;
+}
+
+static void
+store_disk_cache(const char *path, struct xkb_keymap *keymap)
+{
+  char *serialized =
+      xkb_keymap_get_as_string(keymap, XKB_KEYMAP_FORMAT_TEXT_V1);
+
+  if (serialized != NULL) {
+    hikari_config_cache_write_file(path, serialized, strlen(serialized));
+    free(serialized);
+  }
+}
+
+static struct xkb_keymap *
+compile(const struct xkb_rule_names *rule_names, const char *names[5])
+{
+  char *path = disk_cache_path(names);
+  struct xkb_keymap *keymap = NULL;
+
+  if (path != NULL) {
+    keymap = load_disk_cache(path);
+  }
+
+  if (keymap == NULL) {
+    keymap = xkb_keymap_new_from_names(
+        get_context(), rule_names, XKB_KEYMAP_COMPILE_NO_FLAGS);
+
+    if (keymap != NULL && path != NULL) {
+      store_disk_cache(path, keymap);
+    }
+  }
+
+  hikari_free(path);
+
+  return keymap;
+}
+
+struct xkb_keymap *
+hikari_keymap_cache_compile(const struct xkb_rule_names *rule_names)
+{
+  const char *names[5];
+  rule_names_to_array(rule_names, names);
+
+  struct hikari_keymap_cache_entry *lru = &entries[0];
+
+  for (int i = 0; i < HIKARI_KEYMAP_CACHE_SIZE; i++) {
+    struct hikari_keymap_cache_entry *entry = &entries[i];
+
+    if (entry_matches(entry, names)) {
+      entry->last_used = ++uses;
+      return xkb_keymap_ref(entry->keymap);
+    }
+
+    if (entry->last_used < lru->last_used) {
+      lru = entry;
+    }
+  }
+
+  struct xkb_keymap *keymap = compile(rule_names, names);
+
+  if (keymap == NULL) {
+    return NULL;
+  }
+
+  entry_clear(lru);
+
+  for (int i = 0; i < 5; i++) {
+    lru->names[i] = names[i] != NULL ? strdup(names[i]) : NULL;
+  }
+  lru->keymap = xkb_keymap_ref(keymap);
+  lru->last_used = ++uses;
+
+  return keymap;
+}
+
+struct xkb_keymap *
+hikari_keymap_cache_load_file(FILE *file)
+{
+  return xkb_keymap_new_from_file(get_context(),
+      file,
+      XKB_KEYMAP_FORMAT_TEXT_V1,
+      XKB_KEYMAP_COMPILE_NO_FLAGS);
+}
+
+struct xkb_context *
+hikari_keymap_cache_context(void)
+{
+  return get_context();
+}
+
+void
+hikari_keymap_cache_invalidate(void)
+{
+  for (int i = 0; i < HIKARI_KEYMAP_CACHE_SIZE; i++) {
+    entry_clear(&entries[i]);
+    entries[i].last_used = 0;
+  }
+
+  // rehashed by the next keymap that misses the in-memory cache
+  data_hashed = false;
+}
+
+void
+hikari_keymap_cache_fini(void)
+{
+  for (int i = 0; i < HIKARI_KEYMAP_CACHE_SIZE; i++) {
+    entry_clear(&entries[i]);
+  }
+
+  xkb_context_unref(context);
+  context = NULL;
+  data_hashed = false;
+}
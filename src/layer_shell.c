@@ -8,9 +8,13 @@
 #include <wlr/types/wlr_seat.h>
 #include <wlr/types/wlr_xdg_shell.h>
 
+#include <hikari/layout.h>
 #include <hikari/memory.h>
 #include <hikari/output.h>
 #include <hikari/server.h>
+#include <hikari/sheet.h>
+#include <hikari/slab.h>
+#include <hikari/trace.h>
 
 static void
 map(struct hikari_layer *layer);
@@ -167,6 +171,33 @@ apply_state_for_layer(struct hikari_output *output,
   }
 }
 
+static void
+arrange_handler(void *data)
+{
+  struct hikari_output *output = data;
+  struct hikari_workspace *workspace = output->workspace;
+
+  output->arrange_idle = NULL;
+
+  // modes keep their own view of the layout, hikari_layer_shell_resume
+  // arranges again once normal mode is entered
+  if (!hikari_server_in_normal_mode()) {
+    output->arrange_pending = true;
+    return;
+  }
+
+  output->arrange_pending = false;
+
+  for (int i = 0; i < HIKARI_NR_OF_SHEETS; i++) {
+    struct hikari_sheet *sheet = &workspace->sheets[i];
+    struct hikari_layout *layout = sheet->layout;
+
+    if (layout != NULL && hikari_sheet_is_visible(sheet)) {
+      hikari_sheet_apply_split(sheet, layout->split);
+    }
+  }
+}
+
 static void
 calculate_exclusive(struct hikari_output *output)
 {
@@ -180,7 +211,46 @@ calculate_exclusive(struct hikari_output *output)
   apply_state_for_layer(output, ZWLR_LAYER_SHELL_V1_LAYER_TOP, &usable_area);
   apply_state_for_layer(output, ZWLR_LAYER_SHELL_V1_LAYER_BOTTOM, &usable_area);
 
+  if (!memcmp(&output->usable_area, &usable_area, sizeof(struct wlr_box))) {
+    return;
+  }
+
   output->usable_area = usable_area;
+
+  if (output->arrange_idle == NULL) {
+    output->arrange_idle = wl_event_loop_add_idle(
+        hikari_server.event_loop, arrange_handler, output);
+  }
+}
+
+static void
+cache_state(struct hikari_layer_state *cached,
+    struct wlr_layer_surface_v1_state *state)
+{
+  cached->anchor = state->anchor;
+  cached->exclusive_zone = state->exclusive_zone;
+  cached->margin_top = state->margin.top;
+  cached->margin_right = state->margin.right;
+  cached->margin_bottom = state->margin.bottom;
+  cached->margin_left = state->margin.left;
+  cached->desired_width = state->desired_width;
+  cached->desired_height = state->desired_height;
+  cached->layer = state->layer;
+}
+
+static bool
+state_changed(struct hikari_layer_state *cached,
+    struct wlr_layer_surface_v1_state *state)
+{
+  return cached->anchor != state->anchor ||
+         cached->exclusive_zone != state->exclusive_zone ||
+         cached->margin_top != state->margin.top ||
+         cached->margin_right != state->margin.right ||
+         cached->margin_bottom != state->margin.bottom ||
+         cached->margin_left != state->margin.left ||
+         cached->desired_width != state->desired_width ||
+         cached->desired_height != state->desired_height ||
+         cached->layer != state->layer;
 }
 
 void
@@ -203,6 +273,8 @@ hikari_layer_init(
   layer->surface = wlr_layer_surface;
   layer->mapped = false;
 
+  cache_state(&layer->state, &wlr_layer_surface->current);
+
   wlr_layer_surface->output = output->wlr_output;
 
   layer->commit.notify = commit_handler;
@@ -352,21 +424,32 @@ done:
 static void
 commit_handler(struct wl_listener *listener, void *data)
 {
+  HIKARI_TRACE_SCOPE("layer_commit");
+
   struct hikari_layer *layer = wl_container_of(listener, layer, commit);
+  struct wlr_layer_surface_v1_state *state = &layer->surface->current;
   struct wlr_box old_geometry = layer->geometry;
   struct hikari_output *output = layer->output;
 
   if (!layer->mapped) {
+    cache_state(&layer->state, state);
     calculate_geometry(layer);
     return;
   }
 
   assert(layer->mapped);
 
+  if (!state_changed(&layer->state, state)) {
+    damage(layer, false);
+    return;
+  }
+
+  cache_state(&layer->state, state);
+
   calculate_exclusive(layer->output);
   calculate_geometry(layer);
 
-  enum zwlr_layer_shell_v1_layer current_layer = layer->surface->current.layer;
+  enum zwlr_layer_shell_v1_layer current_layer = state->layer;
   bool updated_geometry =
       memcmp(&old_geometry, &layer->geometry, sizeof(struct wlr_box)) != 0;
   bool changed_layer = layer->layer != current_layer;
@@ -427,6 +510,8 @@ map(struct hikari_layer *layer)
 
   layer->mapped = true;
 
+  calculate_exclusive(layer->output);
+
   damage(layer, true);
 
   hikari_server_cursor_focus();
@@ -561,7 +646,7 @@ destroy_popup_handler(struct wl_listener *listener, void *data)
 
   fini_popup(layer_popup);
 
-  hikari_free(layer_popup);
+  hikari_slab_free(&hikari_layer_popup_slab, layer_popup);
 }
 
 static void
@@ -612,7 +697,7 @@ new_popup_popup_handler(struct wl_listener *listener, void *data)
   struct wlr_xdg_popup *wlr_popup = data;
 
   struct hikari_layer_popup *layer_popup_popup =
-      hikari_malloc(sizeof(struct hikari_layer_popup));
+      hikari_slab_alloc(&hikari_layer_popup_slab);
 
   init_popup_popup(layer_popup_popup, layer_popup, wlr_popup);
 }
@@ -627,7 +712,7 @@ new_popup_handler(struct wl_listener *listener, void *data)
 #endif
 
   struct hikari_layer_popup *layer_popup =
-      hikari_malloc(sizeof(struct hikari_layer_popup));
+      hikari_slab_alloc(&hikari_layer_popup_slab);
 
   struct wlr_xdg_popup *wlr_popup = data;
 
@@ -727,3 +812,15 @@ fini_popup(struct hikari_layer_popup *layer_popup)
 }
 
 #endif
+
+void
+hikari_layer_shell_resume(void)
+{
+  struct hikari_output *output;
+  wl_list_for_each (output, &hikari_server.outputs, server_outputs) {
+    if (output->arrange_pending && output->arrange_idle == NULL) {
+      output->arrange_idle = wl_event_loop_add_idle(
+          hikari_server.event_loop, arrange_handler, output);
+    }
+  }
+}
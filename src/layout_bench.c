@@ -0,0 +1,662 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <hikari/configuration.h>
+#include <hikari/geometry.h>
+#include <hikari/layout.h>
+#include <hikari/layout_generator.h>
+#include <hikari/memory.h>
+#include <hikari/sheet.h>
+#include <hikari/split.h>
+#include <hikari/view.h>
+
+// Runs the tiling layouts and nested split trees against stub views and checks
+// that the tiles, grown by their border and trailing gap, never overlap, stay
+// inside the usable area and cover all of it whenever the layout has a view for
+// every slot. The geometry helpers the splits are built from are timed on their
+// own.
+
+#define MAX_VIEWS 500
+#define MAX_DEPTH 10
+#define DEFAULT_DEPTH 6
+#define ITERATIONS 100
+#define GEOMETRY_ITERATIONS 1000000
+
+struct hikari_configuration *hikari_configuration = NULL;
+
+static struct hikari_configuration configuration;
+static uint32_t run = 0;
+static int tiled = 0;
+
+struct bench_spacing {
+  int gap;
+  int border;
+};
+
+static const struct bench_spacing spacings[] = {
+  { .gap = 0, .border = 0 },
+  { .gap = 5, .border = 1 },
+  { .gap = 7, .border = 3 },
+};
+
+enum bench_layout {
+  BENCH_LAYOUT_GRID,
+  BENCH_LAYOUT_QUEUE,
+  BENCH_LAYOUT_STACK,
+  BENCH_LAYOUT_MAIN_STACK
+};
+
+static const char *layout_names[] = { "grid", "queue", "stack", "main-stack" };
+
+static const int reported[] = { 1, 2, 5, 10, 50, 100, 250, 500 };
+
+struct bench_leaf {
+  hikari_layout_func layout;
+  int max;
+};
+
+// every leaf is filled completely once it has max views
+static const struct bench_leaf leaves[] = {
+  { .layout = hikari_sheet_single_layout, .max = 1 },
+  { .layout = hikari_sheet_queue_layout, .max = 2 },
+  { .layout = hikari_sheet_stack_layout, .max = 3 },
+  { .layout = hikari_sheet_grid_layout, .max = 4 },
+};
+
+static volatile int sink;
+
+void
+hikari_view_tile(
+    struct hikari_view *view, struct wlr_box *geometry, bool center)
+{
+  view->geometry = *geometry;
+  view->pending_operation.serial = run;
+  tiled++;
+}
+
+void
+hikari_view_show(struct hikari_view *view)
+{
+  hikari_view_unset_hidden(view);
+}
+
+void
+hikari_view_raise(struct hikari_view *view)
+{}
+
+void
+hikari_view_settle(struct hikari_view *view)
+{}
+
+void
+hikari_layout_init(struct hikari_layout *layout,
+    struct hikari_split *split,
+    struct hikari_sheet *sheet)
+{
+  abort();
+}
+
+struct hikari_split *
+hikari_configuration_lookup_layout(
+    struct hikari_configuration *configuration, char layout_register)
+{
+  return NULL;
+}
+
+struct hikari_layout_generator *
+hikari_layout_generator_ref(struct hikari_layout_generator *generator)
+{
+  return generator;
+}
+
+void
+hikari_layout_generator_unref(struct hikari_layout_generator *generator)
+{}
+
+bool
+hikari_layout_generator_request(struct hikari_layout_generator *generator,
+    int nr_of_views,
+    struct wlr_box *frame,
+    struct wlr_box *boxes)
+{
+  return false;
+}
+
+static double
+elapsed_usec(struct timespec *start, struct timespec *end)
+{
+  return (end->tv_sec - start->tv_sec) * 1e6 +
+         (end->tv_nsec - start->tv_nsec) / 1e3;
+}
+
+static bool
+grid_is_full(int nr_of_views)
+{
+  int nr_of_rows = 1;
+  int nr_of_cols = 1;
+
+  for (int i = 1; i <= nr_of_views; i++) {
+    if (i > nr_of_rows * nr_of_cols) {
+      if (nr_of_cols > nr_of_rows) {
+        nr_of_rows++;
+      } else {
+        nr_of_cols++;
+      }
+    }
+  }
+
+  return nr_of_views == nr_of_rows * nr_of_cols;
+}
+
+static bool
+is_full(enum bench_layout layout, int nr_of_views)
+{
+  switch (layout) {
+    case BENCH_LAYOUT_GRID:
+      return grid_is_full(nr_of_views);
+
+    case BENCH_LAYOUT_MAIN_STACK:
+      return nr_of_views > 1;
+
+    default:
+      return true;
+  }
+}
+
+static void
+cell_box(struct wlr_box *tile, int gap, int border, struct wlr_box *cell)
+{
+  cell->x = tile->x - border;
+  cell->y = tile->y - border;
+  cell->width = tile->width + border * 2 + gap;
+  cell->height = tile->height + border * 2 + gap;
+}
+
+static bool
+intersects(struct wlr_box *a, struct wlr_box *b)
+{
+  return a->x < b->x + b->width && b->x < a->x + a->width &&
+         a->y < b->y + b->height && b->y < a->y + a->height;
+}
+
+static bool
+contains(struct wlr_box *outer, struct wlr_box *inner)
+{
+  return inner->x >= outer->x && inner->y >= outer->y &&
+         inner->x + inner->width <= outer->x + outer->width &&
+         inner->y + inner->height <= outer->y + outer->height;
+}
+
+// returns false if the layout is broken, sets degenerate if the views did not
+// fit and the layout handed out empty tiles
+static bool
+check(struct hikari_view *views,
+    int nr_of_views,
+    struct wlr_box *usable_area,
+    bool full,
+    bool *degenerate)
+{
+  int gap = hikari_configuration->gap;
+  int border = hikari_configuration->border;
+  struct wlr_box region = { .x = usable_area->x + gap,
+    .y = usable_area->y + gap,
+    .width = usable_area->width - gap,
+    .height = usable_area->height - gap };
+  struct wlr_box cell, other_cell;
+  long area = 0;
+
+  *degenerate = false;
+
+  if (tiled != nr_of_views) {
+    fprintf(stderr, "%d views tiled, expected %d\n", tiled, nr_of_views);
+    return false;
+  }
+
+  for (int i = 0; i < nr_of_views; i++) {
+    struct wlr_box *tile = &views[i].geometry;
+
+    if (views[i].pending_operation.serial != run) {
+      fprintf(stderr, "view %d was not tiled\n", i);
+      return false;
+    }
+
+    if (tile->width <= 0 || tile->height <= 0) {
+      *degenerate = true;
+      return true;
+    }
+  }
+
+  for (int i = 0; i < nr_of_views; i++) {
+    cell_box(&views[i].geometry, gap, border, &cell);
+
+    if (!contains(&region, &cell)) {
+      fprintf(stderr,
+          "view %d at %d %d %d %d exceeds usable area\n",
+          i,
+          cell.x,
+          cell.y,
+          cell.width,
+          cell.height);
+      return false;
+    }
+
+    for (int j = 0; j < i; j++) {
+      cell_box(&views[j].geometry, gap, border, &other_cell);
+
+      if (intersects(&cell, &other_cell)) {
+        fprintf(stderr, "views %d and %d are closer than the gap\n", j, i);
+        return false;
+      }
+    }
+
+    area += (long)cell.width * cell.height;
+  }
+
+  if (full && area != (long)region.width * region.height) {
+    fprintf(stderr,
+        "%d views cover %ld of %ld pixels\n",
+        nr_of_views,
+        area,
+        (long)region.width * region.height);
+    return false;
+  }
+
+  return true;
+}
+
+static struct hikari_split *
+create_split(enum bench_layout layout, int nr_of_views)
+{
+  struct hikari_split_container *container =
+      hikari_malloc(sizeof(struct hikari_split_container));
+
+  switch (layout) {
+    case BENCH_LAYOUT_GRID:
+      hikari_split_container_init(
+          container, nr_of_views, hikari_sheet_grid_layout);
+      break;
+
+    case BENCH_LAYOUT_QUEUE:
+      hikari_split_container_init(
+          container, nr_of_views, hikari_sheet_queue_layout);
+      break;
+
+    case BENCH_LAYOUT_STACK:
+      hikari_split_container_init(
+          container, nr_of_views, hikari_sheet_stack_layout);
+      break;
+
+    case BENCH_LAYOUT_MAIN_STACK: {
+      struct hikari_split_container *primary =
+          hikari_malloc(sizeof(struct hikari_split_container));
+      struct hikari_split_vertical *split_vertical =
+          hikari_malloc(sizeof(struct hikari_split_vertical));
+      struct hikari_split_scale scale = {
+        .type = HIKARI_SPLIT_SCALE_TYPE_FIXED,
+        .scale.fixed = hikari_split_scale_default
+      };
+
+      hikari_split_container_init(primary, 1, hikari_sheet_single_layout);
+      hikari_split_container_init(
+          container, nr_of_views, hikari_sheet_stack_layout);
+      hikari_split_vertical_init(split_vertical,
+          &scale,
+          HIKARI_VERTICAL_SPLIT_ORIENTATION_LEFT,
+          (struct hikari_split *)primary,
+          (struct hikari_split *)container);
+
+      return (struct hikari_split *)split_vertical;
+    }
+  }
+
+  return (struct hikari_split *)container;
+}
+
+// alternates vertical and horizontal splits, fixed and dynamic scales and the
+// side that is filled first
+static struct hikari_split *
+create_tree(int depth, int *nodes, int *capacity)
+{
+  if (depth == 0) {
+    const struct bench_leaf *leaf =
+        &leaves[*nodes % (sizeof(leaves) / sizeof(leaves[0]))];
+    struct hikari_split_container *container =
+        hikari_malloc(sizeof(struct hikari_split_container));
+
+    hikari_split_container_init(container, leaf->max, leaf->layout);
+    (*nodes)++;
+    *capacity += leaf->max;
+
+    return (struct hikari_split *)container;
+  }
+
+  int node = (*nodes)++;
+  bool vertical = depth % 2 == 0;
+  bool first = node % 3 != 2;
+  struct hikari_split_scale scale;
+
+  if (node % 2 == 0) {
+    scale.type = HIKARI_SPLIT_SCALE_TYPE_FIXED;
+    scale.scale.fixed = 0.4 + 0.1 * (node % 3);
+  } else {
+    scale.type = HIKARI_SPLIT_SCALE_TYPE_DYNAMIC;
+    scale.scale.dynamic.min = 0.3;
+    scale.scale.dynamic.max = 0.7;
+  }
+
+  struct hikari_split *left = create_tree(depth - 1, nodes, capacity);
+  struct hikari_split *right = create_tree(depth - 1, nodes, capacity);
+
+  if (vertical) {
+    struct hikari_split_vertical *split_vertical =
+        hikari_malloc(sizeof(struct hikari_split_vertical));
+
+    hikari_split_vertical_init(split_vertical,
+        &scale,
+        first ? HIKARI_VERTICAL_SPLIT_ORIENTATION_LEFT
+              : HIKARI_VERTICAL_SPLIT_ORIENTATION_RIGHT,
+        left,
+        right);
+
+    return (struct hikari_split *)split_vertical;
+  } else {
+    struct hikari_split_horizontal *split_horizontal =
+        hikari_malloc(sizeof(struct hikari_split_horizontal));
+
+    hikari_split_horizontal_init(split_horizontal,
+        &scale,
+        first ? HIKARI_HORIZONTAL_SPLIT_ORIENTATION_TOP
+              : HIKARI_HORIZONTAL_SPLIT_ORIENTATION_BOTTOM,
+        left,
+        right);
+
+    return (struct hikari_split *)split_horizontal;
+  }
+}
+
+static void
+fill_sheet(struct hikari_sheet *sheet, struct hikari_view *views, int n)
+{
+  wl_list_init(&sheet->views);
+
+  for (int i = 0; i < n; i++) {
+    wl_list_insert(sheet->views.prev, &views[i].sheet_views);
+  }
+}
+
+static void
+apply(struct hikari_split *split,
+    struct wlr_box *usable_area,
+    struct hikari_view *first)
+{
+  struct wlr_box geometry = *usable_area;
+
+  run++;
+  tiled = 0;
+
+  hikari_split_apply(split, &geometry, first);
+}
+
+static double
+time_apply(struct hikari_split *split,
+    struct wlr_box *usable_area,
+    struct hikari_view *first)
+{
+  struct timespec start, end;
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (int i = 0; i < ITERATIONS; i++) {
+    apply(split, usable_area, first);
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  return elapsed_usec(&start, &end) / ITERATIONS;
+}
+
+static int
+bench_layouts(struct hikari_sheet *sheet,
+    struct hikari_view *views,
+    struct wlr_box *usable_area)
+{
+  int failures = 0;
+
+  for (int layout = BENCH_LAYOUT_GRID; layout <= BENCH_LAYOUT_MAIN_STACK;
+       layout++) {
+    int next_reported = 0;
+    int degenerate_from = 0;
+    double total = 0;
+
+    wl_list_init(&sheet->views);
+
+    for (int n = 1; n <= MAX_VIEWS; n++) {
+      struct hikari_split *split = create_split(layout, n);
+      bool degenerate;
+      bool ok;
+
+      wl_list_insert(sheet->views.prev, &views[n - 1].sheet_views);
+
+      double usec = time_apply(split, usable_area, &views[0]);
+      total += usec;
+
+      ok = check(views, n, usable_area, is_full(layout, n), &degenerate);
+      if (!ok) {
+        fprintf(stderr,
+            "%s layout with gap %d and border %d failed for %d views\n",
+            layout_names[layout],
+            configuration.gap,
+            configuration.border,
+            n);
+        failures++;
+      } else if (degenerate && degenerate_from == 0) {
+        degenerate_from = n;
+      }
+
+      if (n == reported[next_reported]) {
+        printf("%-10s %3d %6d %4d %12.2f %10s\n",
+            layout_names[layout],
+            configuration.gap,
+            configuration.border,
+            n,
+            usec,
+            !ok ? "FAIL" : degenerate ? "too small" : "ok");
+        next_reported++;
+      }
+
+      hikari_split_free(split);
+    }
+
+    printf("%-10s %3d %6d %4s %12.2f",
+        layout_names[layout],
+        configuration.gap,
+        configuration.border,
+        "all",
+        total);
+    if (degenerate_from != 0) {
+      printf(" (views too small from %d views)", degenerate_from);
+    }
+    printf("\n");
+  }
+
+  return failures;
+}
+
+// runs every tree with half of its slots occupied, all of them and more views
+// than it can hold, the surplus views stay untiled
+static int
+bench_trees(struct hikari_sheet *sheet,
+    struct hikari_view *views,
+    struct wlr_box *usable_area,
+    int max_depth)
+{
+  int failures = 0;
+
+  for (int depth = 1; depth <= max_depth; depth++) {
+    int nodes = 0;
+    int capacity = 0;
+    struct hikari_split *split = create_tree(depth, &nodes, &capacity);
+    int counts[] = { capacity / 2, capacity, capacity + 5 };
+
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+      int n = counts[c];
+      int expected = n < capacity ? n : capacity;
+      bool degenerate;
+      bool ok;
+
+      fill_sheet(sheet, views, n);
+
+      double usec = time_apply(split, usable_area, &views[0]);
+
+      ok = check(views,
+          expected,
+          usable_area,
+          n >= capacity,
+          &degenerate);
+      if (!ok) {
+        fprintf(stderr,
+            "split tree of depth %d with gap %d and border %d failed for %d "
+            "views\n",
+            depth,
+            configuration.gap,
+            configuration.border,
+            n);
+        failures++;
+      }
+
+      printf("tree-%-5d %3d %6d %4d %12.2f %10s\n",
+          depth,
+          configuration.gap,
+          configuration.border,
+          n,
+          usec,
+          !ok ? "FAIL" : degenerate ? "too small" : "ok");
+    }
+
+    hikari_split_free(split);
+  }
+
+  return failures;
+}
+
+#define BENCH_GEOMETRY(name, statement)                                        \
+  do {                                                                         \
+    struct timespec start, end;                                                \
+                                                                               \
+    clock_gettime(CLOCK_MONOTONIC, &start);                                    \
+    for (int i = 0; i < GEOMETRY_ITERATIONS; i++) {                            \
+      src.width = 1000 + (i & 1023);                                           \
+      src.height = 600 + (i & 511);                                            \
+      statement;                                                               \
+    }                                                                          \
+    clock_gettime(CLOCK_MONOTONIC, &end);                                      \
+                                                                               \
+    printf("%-32s %8.2f\n",                                                    \
+        name,                                                                  \
+        elapsed_usec(&start, &end) * 1000 / GEOMETRY_ITERATIONS);              \
+  } while (0)
+
+static void
+bench_geometry(struct wlr_box *usable_area)
+{
+  struct wlr_box src = *usable_area;
+  struct wlr_box first, second;
+  struct wlr_box view = { .x = 100, .y = 100, .width = 640, .height = 480 };
+
+  printf("%-32s %8s\n", "geometry", "nsec");
+
+  BENCH_GEOMETRY("split_vertical", {
+    hikari_geometry_split_vertical(
+        &src, src.width / 2, 7, &first, &second);
+    sink += second.width;
+  });
+  BENCH_GEOMETRY("split_horizontal", {
+    hikari_geometry_split_horizontal(
+        &src, src.height / 2, 7, &first, &second);
+    sink += second.height;
+  });
+  BENCH_GEOMETRY("scale_fixed_width",
+      sink += hikari_geometry_scale_fixed_width(&src, 0.4, 5));
+  BENCH_GEOMETRY("scale_fixed_height",
+      sink += hikari_geometry_scale_fixed_height(&src, 0.4, 5));
+  BENCH_GEOMETRY("scale_dynamic_width", {
+    view.width = i & 2047;
+    sink += hikari_geometry_scale_dynamic_width(&src, &view, 0.3, 0.7, 5);
+  });
+  BENCH_GEOMETRY("scale_dynamic_height", {
+    view.height = i & 2047;
+    sink += hikari_geometry_scale_dynamic_height(&src, &view, 0.3, 0.7, 5);
+  });
+  BENCH_GEOMETRY("constrain_relative", {
+    hikari_geometry_constrain_relative(
+        &view, &src, (i & 4095) - 1024, (i & 2047) - 512);
+    sink += view.x + view.y;
+  });
+}
+#undef BENCH_GEOMETRY
+
+int
+main(int argc, char **argv)
+{
+  struct wlr_box usable_area = {
+    .x = 0, .y = 24, .width = 1920, .height = 1056
+  };
+  struct hikari_sheet sheet = { .nr = 1 };
+  int max_depth = DEFAULT_DEPTH;
+  int failures = 0;
+
+  if (argc > 1) {
+    max_depth = atoi(argv[1]);
+
+    if (max_depth < 1 || max_depth > MAX_DEPTH) {
+      fprintf(stderr, "usage: layout-bench [depth 1-%d]\n", MAX_DEPTH);
+      return EXIT_FAILURE;
+    }
+  }
+
+  // a tree holds at most four views per leaf
+  int nr_of_views = (4 << max_depth) + 5;
+  if (nr_of_views < MAX_VIEWS) {
+    nr_of_views = MAX_VIEWS;
+  }
+
+  struct hikari_view *views =
+      hikari_calloc(nr_of_views, sizeof(struct hikari_view));
+
+  hikari_configuration = &configuration;
+
+  for (int i = 0; i < nr_of_views; i++) {
+    views[i].sheet = &sheet;
+    views[i].current_geometry = &views[i].geometry;
+  }
+
+  printf("%-10s %3s %6s %4s %12s %10s\n",
+      "layout",
+      "gap",
+      "border",
+      "n",
+      "usec/apply",
+      "result");
+
+  for (size_t s = 0; s < sizeof(spacings) / sizeof(spacings[0]); s++) {
+    configuration.gap = spacings[s].gap;
+    configuration.border = spacings[s].border;
+
+    failures += bench_layouts(&sheet, views, &usable_area);
+    failures += bench_trees(&sheet, views, &usable_area, max_depth);
+  }
+
+  configuration.gap = spacings[1].gap;
+  configuration.border = spacings[1].border;
+
+  bench_geometry(&usable_area);
+
+  hikari_free(views);
+
+  if (failures > 0) {
+    fprintf(stderr, "%d layouts failed\n", failures);
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,613 @@
+#include <hikari/layout_generator.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <wayland-server-core.h>
+
+#include <hikari/configuration.h>
+#include <hikari/layout.h>
+#include <hikari/memory.h>
+#include <hikari/output.h>
+#include <hikari/server.h>
+#include <hikari/sheet.h>
+#include <hikari/split.h>
+#include <hikari/workspace.h>
+
+static const int HIKARI_LAYOUT_GENERATOR_MAX_BOXES = 1024;
+
+static struct wl_list generators = { &generators, &generators };
+
+static void
+deadline_in(struct timespec *deadline, int msec)
+{
+  clock_gettime(CLOCK_MONOTONIC, deadline);
+
+  deadline->tv_sec += msec / 1000;
+  deadline->tv_nsec += (msec % 1000) * 1000000L;
+
+  if (deadline->tv_nsec >= 1000000000L) {
+    deadline->tv_sec++;
+    deadline->tv_nsec -= 1000000000L;
+  }
+}
+
+static int
+remaining_msec(struct timespec *deadline)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  long msec = (deadline->tv_sec - now.tv_sec) * 1000 +
+              (deadline->tv_nsec - now.tv_nsec) / 1000000L;
+
+  return msec > 0 ? msec : 0;
+}
+
+static void
+reset_reply(struct hikari_layout_generator_reply *reply)
+{
+  hikari_free(reply->boxes);
+
+  reply->boxes = NULL;
+  reply->header = false;
+  reply->nr_of_boxes = 0;
+  reply->received = 0;
+  reply->line_len = 0;
+}
+
+static void
+disconnect_generator(struct hikari_layout_generator *generator)
+{
+  if (generator->event_source != NULL) {
+    wl_event_source_remove(generator->event_source);
+    generator->event_source = NULL;
+  }
+
+  if (generator->timeout != NULL) {
+    wl_event_source_remove(generator->timeout);
+    generator->timeout = NULL;
+  }
+
+  if (generator->fd != -1) {
+    close(generator->fd);
+    generator->fd = -1;
+  }
+
+  generator->connecting = false;
+  generator->in_flight = false;
+  generator->queued = false;
+
+  reset_reply(&generator->reply);
+}
+
+static void
+backoff(struct hikari_layout_generator *generator, const char *reason)
+{
+  fprintf(stderr,
+      "layout generator error: \"%s\" %s\n",
+      generator->path,
+      reason);
+
+  disconnect_generator(generator);
+  deadline_in(&generator->retry, HIKARI_LAYOUT_GENERATOR_BACKOFF);
+}
+
+static bool
+same_request(struct hikari_layout_generator_request *a,
+    struct hikari_layout_generator_request *b)
+{
+  return a->nr_of_views == b->nr_of_views && a->gap == b->gap &&
+         a->border == b->border && a->frame.x == b->frame.x &&
+         a->frame.y == b->frame.y && a->frame.width == b->frame.width &&
+         a->frame.height == b->frame.height;
+}
+
+static bool
+send_request(struct hikari_layout_generator *generator,
+    struct hikari_layout_generator_request *request)
+{
+  char buf[128];
+
+  request->seq = ++generator->seq;
+
+  int len = snprintf(buf,
+      sizeof(buf),
+      "%" PRIu32 " %d %d %d %d %d %d %d\n",
+      request->seq,
+      request->nr_of_views,
+      request->frame.x,
+      request->frame.y,
+      request->frame.width,
+      request->frame.height,
+      request->gap,
+      request->border);
+
+  ssize_t ret;
+  do {
+    ret = send(generator->fd, buf, len, MSG_NOSIGNAL);
+  } while (ret == -1 && errno == EINTR);
+
+  // requests are tiny and at most one is outstanding, a short write means
+  // the generator stopped reading
+  if (ret != len) {
+    backoff(generator, "does not accept requests");
+    return false;
+  }
+
+  generator->pending = *request;
+  generator->in_flight = true;
+
+  wl_event_source_timer_update(
+      generator->timeout, HIKARI_LAYOUT_GENERATOR_TIMEOUT);
+
+  return true;
+}
+
+static void
+send_queued(struct hikari_layout_generator *generator)
+{
+  if (generator->queued) {
+    generator->queued = false;
+    send_request(generator, &generator->next);
+  }
+}
+
+static void
+submit(struct hikari_layout_generator *generator,
+    struct hikari_layout_generator_request *request)
+{
+  if (generator->in_flight && same_request(&generator->pending, request)) {
+    return;
+  }
+
+  if (generator->connecting || generator->in_flight) {
+    generator->next = *request;
+    generator->queued = true;
+    return;
+  }
+
+  send_request(generator, request);
+}
+
+static void
+reapply_layouts(struct hikari_layout_generator *generator)
+{
+  // layouts are only applied in normal mode, apply the reply once it resumes
+  if (!hikari_server_in_normal_mode()) {
+    generator->reapply_pending = true;
+    return;
+  }
+
+  generator->reapply_pending = false;
+
+  struct hikari_output *output;
+  wl_list_for_each (output, &hikari_server.outputs, server_outputs) {
+    struct hikari_workspace *workspace = output->workspace;
+
+    for (int i = 0; i < HIKARI_NR_OF_SHEETS; i++) {
+      struct hikari_sheet *sheet = &workspace->sheets[i];
+      struct hikari_layout *layout = sheet->layout;
+
+      if (layout != NULL && hikari_sheet_is_visible(sheet) &&
+          hikari_split_uses_generator(layout->split, generator)) {
+        hikari_sheet_apply_split(sheet, layout->split);
+      }
+    }
+  }
+}
+
+static bool
+entry_matches(struct hikari_layout_generator_entry *entry,
+    struct hikari_layout_generator_request *request)
+{
+  return entry->boxes != NULL && entry->nr_of_views == request->nr_of_views &&
+         entry->gap == request->gap && entry->border == request->border &&
+         entry->frame.x == request->frame.x &&
+         entry->frame.y == request->frame.y &&
+         entry->frame.width == request->frame.width &&
+         entry->frame.height == request->frame.height;
+}
+
+static struct hikari_layout_generator_entry *
+lookup_entry(struct hikari_layout_generator *generator,
+    struct hikari_layout_generator_request *request)
+{
+  for (int i = 0; i < HIKARI_LAYOUT_GENERATOR_CACHE_SIZE; i++) {
+    struct hikari_layout_generator_entry *entry = &generator->entries[i];
+
+    if (entry_matches(entry, request)) {
+      return entry;
+    }
+  }
+
+  return NULL;
+}
+
+static void
+store_entry(struct hikari_layout_generator *generator,
+    struct hikari_layout_generator_request *request,
+    struct wlr_box *boxes)
+{
+  struct hikari_layout_generator_entry *entry =
+      &generator->entries[generator->next_entry];
+  size_t size = request->nr_of_views * sizeof(struct wlr_box);
+
+  hikari_free(entry->boxes);
+
+  entry->nr_of_views = request->nr_of_views;
+  entry->gap = request->gap;
+  entry->border = request->border;
+  entry->frame = request->frame;
+  entry->boxes = hikari_malloc(size);
+  memcpy(entry->boxes, boxes, size);
+
+  generator->next_entry =
+      (generator->next_entry + 1) % HIKARI_LAYOUT_GENERATOR_CACHE_SIZE;
+}
+
+static bool
+clamp_boxes(struct wlr_box *boxes, int nr_of_boxes, struct wlr_box *frame)
+{
+  for (int i = 0; i < nr_of_boxes; i++) {
+    struct wlr_box clamped;
+
+    if (!wlr_box_intersection(&clamped, &boxes[i], frame)) {
+      return false;
+    }
+
+    boxes[i] = clamped;
+  }
+
+  return true;
+}
+
+static bool
+complete_reply(struct hikari_layout_generator *generator)
+{
+  struct hikari_layout_generator_reply *reply = &generator->reply;
+  struct hikari_layout_generator_request *pending = &generator->pending;
+
+  // anything but the reply to the outstanding request was abandoned after
+  // the timeout and is dropped
+  if (!generator->in_flight || reply->seq != pending->seq) {
+    reset_reply(reply);
+    return true;
+  }
+
+  if (reply->nr_of_boxes != pending->nr_of_views) {
+    backoff(generator, "replied with the wrong number of views");
+    return false;
+  }
+
+  if (!clamp_boxes(reply->boxes, reply->nr_of_boxes, &pending->frame)) {
+    backoff(generator, "placed a view outside of the frame");
+    return false;
+  }
+
+  store_entry(generator, pending, reply->boxes);
+  reset_reply(reply);
+
+  generator->in_flight = false;
+  wl_event_source_timer_update(generator->timeout, 0);
+
+  send_queued(generator);
+  reapply_layouts(generator);
+
+  return generator->fd != -1;
+}
+
+static bool
+parse_box(const char *line, struct wlr_box *box)
+{
+  if (sscanf(line, "%d %d %d %d", &box->x, &box->y, &box->width, &box->height) !=
+      4) {
+    return false;
+  }
+
+  return box->width > 0 && box->height > 0;
+}
+
+static bool
+parse_line(struct hikari_layout_generator *generator)
+{
+  struct hikari_layout_generator_reply *reply = &generator->reply;
+
+  if (!reply->header) {
+    if (sscanf(reply->line,
+            "%" SCNu32 " %d",
+            &reply->seq,
+            &reply->nr_of_boxes) != 2 ||
+        reply->nr_of_boxes <= 0 ||
+        reply->nr_of_boxes > HIKARI_LAYOUT_GENERATOR_MAX_BOXES) {
+      backoff(generator, "sent a malformed reply");
+      return false;
+    }
+
+    reply->header = true;
+    reply->received = 0;
+    reply->boxes = hikari_calloc(reply->nr_of_boxes, sizeof(struct wlr_box));
+
+    return true;
+  }
+
+  if (!parse_box(reply->line, &reply->boxes[reply->received])) {
+    backoff(generator, "sent a malformed reply");
+    return false;
+  }
+
+  if (++reply->received == reply->nr_of_boxes) {
+    return complete_reply(generator);
+  }
+
+  return true;
+}
+
+static bool
+read_replies(struct hikari_layout_generator *generator)
+{
+  struct hikari_layout_generator_reply *reply = &generator->reply;
+  char chunk[4096];
+
+  for (;;) {
+    ssize_t ret = recv(generator->fd, chunk, sizeof(chunk), 0);
+
+    if (ret == 0) {
+      backoff(generator, "closed the connection");
+      return false;
+    } else if (ret == -1) {
+      if (errno == EINTR) {
+        continue;
+      } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        return true;
+      }
+      backoff(generator, "could not be read from");
+      return false;
+    }
+
+    for (ssize_t i = 0; i < ret; i++) {
+      if (chunk[i] != '\n') {
+        if (reply->line_len == sizeof(reply->line) - 1) {
+          backoff(generator, "sent a malformed reply");
+          return false;
+        }
+        reply->line[reply->line_len++] = chunk[i];
+        continue;
+      }
+
+      reply->line[reply->line_len] = '\0';
+      reply->line_len = 0;
+
+      if (!parse_line(generator)) {
+        return false;
+      }
+    }
+  }
+}
+
+static bool
+finish_connect(struct hikari_layout_generator *generator)
+{
+  int error = 0;
+  socklen_t len = sizeof(error);
+
+  if (getsockopt(generator->fd, SOL_SOCKET, SO_ERROR, &error, &len) == -1 ||
+      error != 0) {
+    backoff(generator, "could not be connected to");
+    return false;
+  }
+
+  generator->connecting = false;
+  wl_event_source_fd_update(generator->event_source, WL_EVENT_READABLE);
+
+  send_queued(generator);
+
+  return generator->fd != -1;
+}
+
+static int
+generator_handler(int fd, uint32_t mask, void *data)
+{
+  struct hikari_layout_generator *generator = data;
+
+  if (generator->connecting) {
+    if (mask & (WL_EVENT_WRITABLE | WL_EVENT_HANGUP | WL_EVENT_ERROR)) {
+      finish_connect(generator);
+    }
+    return 0;
+  }
+
+  if (mask & WL_EVENT_READABLE) {
+    if (!read_replies(generator)) {
+      return 0;
+    }
+  }
+
+  if (mask & (WL_EVENT_HANGUP | WL_EVENT_ERROR)) {
+    backoff(generator, "closed the connection");
+  }
+
+  return 0;
+}
+
+static int
+timeout_handler(void *data)
+{
+  struct hikari_layout_generator *generator = data;
+
+  if (!generator->in_flight) {
+    return 0;
+  }
+
+  fprintf(stderr,
+      "layout generator error: \"%s\" did not respond in time\n",
+      generator->path);
+
+  // keep the connection, a late reply is recognized by its sequence number
+  generator->in_flight = false;
+  send_queued(generator);
+
+  return 0;
+}
+
+static bool
+connect_generator(struct hikari_layout_generator *generator)
+{
+  struct sockaddr_un addr = { .sun_family = AF_UNIX };
+
+  if (strlen(generator->path) >= sizeof(addr.sun_path)) {
+    backoff(generator, "is not a valid socket path");
+    return false;
+  }
+  strcpy(addr.sun_path, generator->path);
+
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd == -1) {
+    backoff(generator, "could not be connected to");
+    return false;
+  }
+
+  if (fcntl(fd, F_SETFD, FD_CLOEXEC) == -1 ||
+      fcntl(fd, F_SETFL, O_NONBLOCK) == -1) {
+    close(fd);
+    backoff(generator, "could not be connected to");
+    return false;
+  }
+
+  bool connecting = false;
+  if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) == -1) {
+    if (errno == EINPROGRESS) {
+      connecting = true;
+    } else if (errno == EAGAIN) {
+      // the listen backlog is full, try again with the next request
+      close(fd);
+      return false;
+    } else {
+      close(fd);
+      backoff(generator, "could not be connected to");
+      return false;
+    }
+  }
+
+  generator->fd = fd;
+  generator->connecting = connecting;
+  generator->event_source = wl_event_loop_add_fd(hikari_server.event_loop,
+      fd,
+      connecting ? WL_EVENT_WRITABLE : WL_EVENT_READABLE,
+      generator_handler,
+      generator);
+  generator->timeout = wl_event_loop_add_timer(
+      hikari_server.event_loop, timeout_handler, generator);
+
+  return true;
+}
+
+struct hikari_layout_generator *
+hikari_layout_generator_create(const char *path)
+{
+  struct hikari_layout_generator *generator =
+      hikari_malloc(sizeof(struct hikari_layout_generator));
+
+  generator->path = hikari_malloc(strlen(path) + 1);
+  strcpy(generator->path, path);
+
+  generator->fd = -1;
+  generator->refs = 1;
+  generator->connecting = false;
+  generator->event_source = NULL;
+  generator->timeout = NULL;
+  generator->retry = (struct timespec){ 0 };
+  generator->seq = 0;
+  generator->in_flight = false;
+  generator->queued = false;
+  generator->reply.boxes = NULL;
+  reset_reply(&generator->reply);
+  generator->reapply_pending = false;
+  generator->next_entry = 0;
+
+  for (int i = 0; i < HIKARI_LAYOUT_GENERATOR_CACHE_SIZE; i++) {
+    generator->entries[i].boxes = NULL;
+  }
+
+  wl_list_insert(&generators, &generator->generators);
+
+  return generator;
+}
+
+struct hikari_layout_generator *
+hikari_layout_generator_ref(struct hikari_layout_generator *generator)
+{
+  generator->refs++;
+
+  return generator;
+}
+
+void
+hikari_layout_generator_unref(struct hikari_layout_generator *generator)
+{
+  if (--generator->refs > 0) {
+    return;
+  }
+
+  disconnect_generator(generator);
+  wl_list_remove(&generator->generators);
+
+  for (int i = 0; i < HIKARI_LAYOUT_GENERATOR_CACHE_SIZE; i++) {
+    hikari_free(generator->entries[i].boxes);
+  }
+
+  hikari_free(generator->path);
+  hikari_free(generator);
+}
+
+bool
+hikari_layout_generator_request(struct hikari_layout_generator *generator,
+    int nr_of_views,
+    struct wlr_box *frame,
+    struct wlr_box *boxes)
+{
+  struct hikari_layout_generator_request request = {
+    .nr_of_views = nr_of_views,
+    .gap = hikari_configuration->gap,
+    .border = hikari_configuration->border,
+    .frame = *frame,
+  };
+
+  struct hikari_layout_generator_entry *entry =
+      lookup_entry(generator, &request);
+
+  if (entry != NULL) {
+    memcpy(boxes, entry->boxes, nr_of_views * sizeof(struct wlr_box));
+    return true;
+  }
+
+  if (generator->fd == -1) {
+    if (remaining_msec(&generator->retry) > 0 ||
+        !connect_generator(generator)) {
+      return false;
+    }
+  }
+
+  // the layout is applied once the reply arrives, until then the caller
+  // falls back to the grid algorithm
+  submit(generator, &request);
+
+  return false;
+}
+
+void
+hikari_layout_generator_resume(void)
+{
+  struct hikari_layout_generator *generator;
+  wl_list_for_each (generator, &generators, generators) {
+    if (generator->reapply_pending) {
+      reapply_layouts(generator);
+    }
+  }
+}
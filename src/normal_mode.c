@@ -10,6 +10,7 @@
 #include <hikari/indicator.h>
 #include <hikari/indicator_frame.h>
 #include <hikari/keyboard.h>
+#include <hikari/layout_generator.h>
 #include <hikari/renderer.h>
 #include <hikari/server.h>
 #include <hikari/view.h>
@@ -47,6 +48,13 @@ handle_input(struct hikari_binding_group *map, uint32_t code)
 
       event_action = &binding->action->begin;
       if (event_action->action != NULL) {
+#ifdef HAVE_RECORD
+        hikari_recorder_mark(&hikari_server.recorder,
+            HIKARI_RECORDER_EVENT_ACTION,
+            code,
+            0,
+            0);
+#endif
         event_action->action(event_action->arg);
       }
       return true;
@@ -63,6 +71,10 @@ handle_pending_action(void)
       hikari_server.normal_mode.pending_action;
 
   if (pending_action != NULL) {
+#ifdef HAVE_RECORD
+    hikari_recorder_mark(
+        &hikari_server.recorder, HIKARI_RECORDER_EVENT_ACTION, 0, 0, 0);
+#endif
     pending_action->action(pending_action->arg);
     hikari_server.normal_mode.pending_action = NULL;
     return true;
@@ -356,4 +368,12 @@ hikari_normal_mode_enter(void)
 
   server->mode->cancel();
   server->mode = (struct hikari_mode *)&server->normal_mode;
+
+#ifdef HAVE_INOTIFY
+  hikari_config_watch_resume(&server->config_watch);
+#endif
+#ifdef HAVE_LAYERSHELL
+  hikari_layer_shell_resume();
+#endif
+  hikari_layout_generator_resume();
 }
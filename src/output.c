@@ -4,7 +4,9 @@
 
 #include <wlr/backend.h>
 
+#include <hikari/animation.h>
 #include <hikari/memory.h>
+#include <hikari/placement.h>
 #include <hikari/renderer.h>
 #include <hikari/server.h>
 #ifdef HAVE_XWAYLAND
@@ -104,6 +106,10 @@ hikari_output_damage_whole(struct hikari_output *output)
   assert(output != NULL);
 
   wlr_output_damage_add_whole(output->damage);
+
+  if (hikari_server.track_damage) {
+    output->damage_overlay.flash = true;
+  }
 }
 
 void
@@ -147,6 +153,22 @@ hikari_output_enable(struct hikari_output *output)
   hikari_output_damage_whole(output);
 
   output->enabled = true;
+
+  hikari_output_update_cursor_plane(output);
+}
+
+void
+hikari_output_update_cursor_plane(struct hikari_output *output)
+{
+  struct wlr_output *wlr_output = output->wlr_output;
+
+  bool software_cursor = wlr_output->transform != WL_OUTPUT_TRANSFORM_NORMAL ||
+                         wlr_output->scale != (int)wlr_output->scale;
+
+  if (software_cursor != output->software_cursor) {
+    wlr_output_lock_software_cursors(wlr_output, software_cursor);
+    output->software_cursor = software_cursor;
+  }
 }
 
 static void
@@ -225,6 +247,10 @@ hikari_output_init(struct hikari_output *output, struct wlr_output *wlr_output)
   output->damage = wlr_output_damage_create(wlr_output);
   output->background = NULL;
   output->enabled = false;
+  output->software_cursor = false;
+  output->cursor_stats = (struct hikari_output_cursor_stats){ 0 };
+  hikari_damage_overlay_init(&output->damage_overlay, output);
+  hikari_damage_ring_init(&output->damage_ring);
   output->workspace = hikari_malloc(sizeof(struct hikari_workspace));
 
 #ifdef HAVE_XWAYLAND
@@ -237,6 +263,8 @@ hikari_output_init(struct hikari_output *output, struct wlr_output *wlr_output)
   wl_list_init(&output->layers[ZWLR_LAYER_SHELL_V1_LAYER_TOP]);
   wl_list_init(&output->layers[ZWLR_LAYER_SHELL_V1_LAYER_BOTTOM]);
   wl_list_init(&output->layers[ZWLR_LAYER_SHELL_V1_LAYER_BACKGROUND]);
+  output->arrange_idle = NULL;
+  output->arrange_pending = false;
 #endif
 
   hikari_workspace_init(output->workspace, output);
@@ -285,6 +313,8 @@ hikari_output_init(struct hikari_output *output, struct wlr_output *wlr_output)
 
     output_geometry(output);
 
+    hikari_placement_restore(output);
+
     if (first) {
       hikari_workspace_merge(
           hikari_server.noop_output->workspace, output->workspace);
@@ -303,9 +333,16 @@ hikari_output_fini(struct hikari_output *output)
   close_layers(&output->layers[ZWLR_LAYER_SHELL_V1_LAYER_TOP]);
   close_layers(&output->layers[ZWLR_LAYER_SHELL_V1_LAYER_BOTTOM]);
   close_layers(&output->layers[ZWLR_LAYER_SHELL_V1_LAYER_BACKGROUND]);
+
+  if (output->arrange_idle != NULL) {
+    wl_event_source_remove(output->arrange_idle);
+    output->arrange_idle = NULL;
+  }
 #endif
 
   hikari_output_disable(output);
+  hikari_damage_overlay_fini(&output->damage_overlay);
+  hikari_damage_ring_fini(&output->damage_ring);
 
   wl_list_remove(&output->destroy.link);
 
@@ -323,8 +360,12 @@ hikari_output_fini(struct hikari_output *output)
       merge_workspace = hikari_server.noop_output->workspace;
     }
 
+    hikari_placement_store(output);
     hikari_workspace_merge(workspace, merge_workspace);
 
+    // views that did not move with the workspace may still animate here
+    hikari_animations_cancel(output);
+
     if (!hikari_server_in_lock_mode()) {
       if (!hikari_server_in_normal_mode()) {
         hikari_server_enter_normal_mode(NULL);
@@ -0,0 +1,396 @@
+#include <hikari/overview_mode.h>
+
+#include <wlr/types/wlr_cursor.h>
+
+#include <hikari/configuration.h>
+#include <hikari/indicator.h>
+#include <hikari/keyboard.h>
+#include <hikari/memory.h>
+#include <hikari/normal_mode.h>
+#include <hikari/output.h>
+#include <hikari/renderer.h>
+#include <hikari/server.h>
+#include <hikari/sheet.h>
+#include <hikari/view.h>
+#include <hikari/workspace.h>
+
+#define GAP 10
+
+static struct hikari_overview_mode *
+get_mode(void)
+{
+  struct hikari_overview_mode *mode = &hikari_server.overview_mode;
+
+  assert(mode == (struct hikari_overview_mode *)hikari_server.mode);
+
+  return mode;
+}
+
+static void
+reserve(struct hikari_overview_mode *mode, int nr_of_thumbnails)
+{
+  if (nr_of_thumbnails <= mode->capacity) {
+    return;
+  }
+
+  int capacity = mode->capacity == 0 ? 16 : mode->capacity;
+  while (capacity < nr_of_thumbnails) {
+    capacity *= 2;
+  }
+
+  hikari_free(mode->thumbnails);
+  mode->thumbnails = hikari_malloc(capacity * sizeof(struct hikari_thumbnail));
+  mode->capacity = capacity;
+}
+
+static void
+place_thumbnail(struct hikari_thumbnail *thumbnail,
+    struct hikari_view *view,
+    struct wlr_box *cell)
+{
+  struct wlr_box *geometry = hikari_view_geometry(view);
+  int bar_height = hikari_configuration->font.height + GAP;
+  int width = cell->width - 2 * GAP;
+  int height = cell->height - 2 * GAP - bar_height;
+  double scale = 1;
+
+  if (geometry->width > 0 && geometry->height > 0) {
+    double scale_x = (double)width / geometry->width;
+    double scale_y = (double)height / geometry->height;
+
+    scale = scale_x < scale_y ? scale_x : scale_y;
+  }
+
+  if (scale > 1) {
+    scale = 1;
+  } else if (scale < 0) {
+    scale = 0;
+  }
+
+  thumbnail->view = view;
+  thumbnail->scale = scale;
+  thumbnail->geometry.width = geometry->width * scale;
+  thumbnail->geometry.height = geometry->height * scale;
+  thumbnail->geometry.x =
+      cell->x + (cell->width - thumbnail->geometry.width) / 2;
+  thumbnail->geometry.y = cell->y + GAP;
+}
+
+static void
+layout(struct hikari_overview_mode *mode)
+{
+  struct hikari_workspace *workspace = mode->output->workspace;
+  struct wlr_box *usable_area = &mode->output->usable_area;
+  int nr_of_thumbnails = 0;
+
+  for (int i = 0; i < HIKARI_NR_OF_SHEETS; i++) {
+    nr_of_thumbnails += wl_list_length(&workspace->sheets[i].views);
+  }
+
+  reserve(mode, nr_of_thumbnails);
+  mode->nr_of_thumbnails = nr_of_thumbnails;
+
+  int columns = 1;
+  while (columns * columns < nr_of_thumbnails) {
+    columns++;
+  }
+
+  int rows = (nr_of_thumbnails + columns - 1) / columns;
+  if (rows == 0) {
+    rows = 1;
+  }
+
+  struct wlr_box cell = { .width = usable_area->width / columns,
+    .height = usable_area->height / rows };
+
+  int n = 0;
+  for (int i = 0; i < HIKARI_NR_OF_SHEETS; i++) {
+    struct hikari_view *view;
+    wl_list_for_each (view, &workspace->sheets[i].views, sheet_views) {
+      cell.x = usable_area->x + (n % columns) * cell.width;
+      cell.y = usable_area->y + (n / columns) * cell.height;
+
+      place_thumbnail(&mode->thumbnails[n], view, &cell);
+      n++;
+    }
+  }
+
+  mode->columns = columns;
+
+  if (mode->selected >= nr_of_thumbnails) {
+    mode->selected = nr_of_thumbnails > 0 ? nr_of_thumbnails - 1 : 0;
+  }
+}
+
+static void
+update_title(struct hikari_overview_mode *mode)
+{
+  const char *title = NULL;
+
+  if (mode->nr_of_thumbnails > 0) {
+    title = mode->thumbnails[mode->selected].view->title;
+  }
+
+  hikari_indicator_bar_update(&mode->title, mode->output, title);
+}
+
+static void
+select_thumbnail(struct hikari_overview_mode *mode, int selected)
+{
+  if (selected < 0 || selected >= mode->nr_of_thumbnails ||
+      selected == mode->selected) {
+    return;
+  }
+
+  mode->selected = selected;
+
+  update_title(mode);
+  hikari_output_damage_whole(mode->output);
+}
+
+static int
+thumbnail_at(struct hikari_overview_mode *mode, double lx, double ly)
+{
+  struct hikari_output *output = mode->output;
+  double ox = lx - output->geometry.x;
+  double oy = ly - output->geometry.y;
+
+  for (int i = 0; i < mode->nr_of_thumbnails; i++) {
+    if (wlr_box_contains_point(&mode->thumbnails[i].geometry, ox, oy)) {
+      return i;
+    }
+  }
+
+  return -1;
+}
+
+static void
+confirm_overview(void)
+{
+  struct hikari_overview_mode *mode = get_mode();
+  struct hikari_view *view = NULL;
+
+  if (mode->nr_of_thumbnails > 0) {
+    view = mode->thumbnails[mode->selected].view;
+  }
+
+  hikari_server_enter_normal_mode(NULL);
+
+  if (view != NULL) {
+    hikari_server_switch_to_view(view);
+  }
+}
+
+static int
+timer_handler(void *data)
+{
+  struct hikari_overview_mode *mode = data;
+
+  layout(mode);
+  update_title(mode);
+
+  mode->frame_due = true;
+  hikari_output_damage_whole(mode->output);
+
+  wl_event_source_timer_update(mode->timer, HIKARI_OVERVIEW_MODE_REFRESH_MSEC);
+
+  return 0;
+}
+
+static void
+handle_keysym(
+    struct hikari_keyboard *keyboard, uint32_t keycode, xkb_keysym_t sym)
+{
+  struct hikari_overview_mode *mode = get_mode();
+  int nr_of_thumbnails = mode->nr_of_thumbnails;
+
+  switch (sym) {
+    case XKB_KEY_Left:
+    case XKB_KEY_h:
+      select_thumbnail(mode, mode->selected - 1);
+      break;
+
+    case XKB_KEY_Right:
+    case XKB_KEY_l:
+      select_thumbnail(mode, mode->selected + 1);
+      break;
+
+    case XKB_KEY_Up:
+    case XKB_KEY_k:
+      select_thumbnail(mode, mode->selected - mode->columns);
+      break;
+
+    case XKB_KEY_Down:
+    case XKB_KEY_j:
+      select_thumbnail(mode, mode->selected + mode->columns);
+      break;
+
+    case XKB_KEY_Tab:
+      if (nr_of_thumbnails > 0) {
+        select_thumbnail(mode, (mode->selected + 1) % nr_of_thumbnails);
+      }
+      break;
+
+    case XKB_KEY_ISO_Left_Tab:
+      if (nr_of_thumbnails > 0) {
+        select_thumbnail(mode,
+            (mode->selected + nr_of_thumbnails - 1) % nr_of_thumbnails);
+      }
+      break;
+
+    case XKB_KEY_Return:
+    case XKB_KEY_space:
+      confirm_overview();
+      break;
+
+    case XKB_KEY_Escape:
+    case XKB_KEY_q:
+      hikari_server_enter_normal_mode(NULL);
+      break;
+  }
+}
+
+static void
+key_handler(
+    struct hikari_keyboard *keyboard, struct wlr_event_keyboard_key *event)
+{
+  if (event->state == WL_KEYBOARD_KEY_STATE_PRESSED) {
+    uint32_t keycode = event->keycode + 8;
+    hikari_keyboard_for_keysym(keyboard, keycode, handle_keysym);
+  }
+}
+
+static void
+modifiers_handler(struct hikari_keyboard *keyboard)
+{}
+
+static void
+cancel(void)
+{
+  struct hikari_overview_mode *mode = get_mode();
+
+  wl_event_source_remove(mode->timer);
+  mode->timer = NULL;
+
+  hikari_indicator_bar_fini(&mode->title);
+  hikari_output_damage_whole(mode->output);
+
+  mode->nr_of_thumbnails = 0;
+  mode->output = NULL;
+}
+
+static void
+button_handler(
+    struct hikari_cursor *cursor, struct wlr_event_pointer_button *event)
+{
+  struct hikari_overview_mode *mode = get_mode();
+
+  if (event->state != WLR_BUTTON_RELEASED) {
+    return;
+  }
+
+  int selected = thumbnail_at(
+      mode, cursor->wlr_cursor->x, cursor->wlr_cursor->y);
+
+  if (selected != -1) {
+    select_thumbnail(mode, selected);
+    confirm_overview();
+  }
+}
+
+static void
+cursor_move(uint32_t time_msec)
+{
+  struct hikari_overview_mode *mode = get_mode();
+  struct wlr_cursor *wlr_cursor = hikari_server.cursor.wlr_cursor;
+
+  int selected = thumbnail_at(mode, wlr_cursor->x, wlr_cursor->y);
+
+  if (selected != -1) {
+    select_thumbnail(mode, selected);
+  }
+}
+
+void
+hikari_overview_mode_init(struct hikari_overview_mode *overview_mode)
+{
+  overview_mode->mode.key_handler = key_handler;
+  overview_mode->mode.button_handler = button_handler;
+  overview_mode->mode.modifiers_handler = modifiers_handler;
+  overview_mode->mode.render = hikari_renderer_overview_mode;
+  overview_mode->mode.cancel = cancel;
+  overview_mode->mode.cursor_move = cursor_move;
+  overview_mode->output = NULL;
+  overview_mode->thumbnails = NULL;
+  overview_mode->nr_of_thumbnails = 0;
+  overview_mode->capacity = 0;
+  overview_mode->columns = 1;
+  overview_mode->selected = 0;
+  overview_mode->timer = NULL;
+  overview_mode->frame_due = false;
+}
+
+void
+hikari_overview_mode_fini(struct hikari_overview_mode *overview_mode)
+{
+  hikari_free(overview_mode->thumbnails);
+}
+
+void
+hikari_overview_mode_enter(void)
+{
+  struct hikari_overview_mode *mode = &hikari_server.overview_mode;
+  struct hikari_workspace *workspace = hikari_server.workspace;
+
+  mode->output = workspace->output;
+  mode->selected = 0;
+
+  layout(mode);
+
+  for (int i = 0; i < mode->nr_of_thumbnails; i++) {
+    if (mode->thumbnails[i].view == workspace->focus_view) {
+      mode->selected = i;
+      break;
+    }
+  }
+
+  hikari_indicator_bar_init(&mode->title,
+      &hikari_server.indicator,
+      GAP,
+      hikari_configuration->indicator_selected);
+  update_title(mode);
+
+  mode->frame_due = true;
+  mode->timer =
+      wl_event_loop_add_timer(hikari_server.event_loop, timer_handler, mode);
+  wl_event_source_timer_update(mode->timer, HIKARI_OVERVIEW_MODE_REFRESH_MSEC);
+
+  hikari_server.mode = (struct hikari_mode *)mode;
+
+  hikari_output_damage_whole(mode->output);
+}
+
+void
+hikari_overview_mode_refresh(struct hikari_overview_mode *overview_mode)
+{
+  layout(overview_mode);
+  update_title(overview_mode);
+
+  hikari_output_damage_whole(overview_mode->output);
+}
+
+bool
+hikari_overview_mode_throttles(
+    struct hikari_overview_mode *overview_mode, struct hikari_output *output)
+{
+  if (overview_mode->output != output) {
+    return false;
+  }
+
+  if (overview_mode->frame_due) {
+    overview_mode->frame_due = false;
+    return false;
+  }
+
+  return true;
+}
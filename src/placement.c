@@ -0,0 +1,234 @@
+#include <hikari/placement.h>
+
+#include <string.h>
+
+#include <hikari/layout.h>
+#include <hikari/memory.h>
+#include <hikari/output.h>
+#include <hikari/server.h>
+#include <hikari/sheet.h>
+#include <hikari/slab.h>
+#include <hikari/split.h>
+#include <hikari/view.h>
+#include <hikari/workspace.h>
+
+static struct hikari_placement *
+find_placement(const char *output_name)
+{
+  struct hikari_placement *placement;
+  wl_list_for_each (placement, &hikari_server.placements, server_placements) {
+    if (!strcmp(placement->output_name, output_name)) {
+      return placement;
+    }
+  }
+
+  return NULL;
+}
+
+static void
+destroy_placement(struct hikari_placement *placement)
+{
+  struct hikari_view_placement *view_placement, *view_placement_temp;
+  wl_list_for_each_safe (view_placement,
+      view_placement_temp,
+      &placement->views,
+      placement_views) {
+    hikari_placement_forget(view_placement->view);
+  }
+
+  for (int i = 0; i < HIKARI_NR_OF_SHEETS; i++) {
+    if (placement->splits[i] != NULL) {
+      hikari_split_free(placement->splits[i]);
+    }
+  }
+  hikari_free(placement->splits);
+
+  wl_list_remove(&placement->server_placements);
+  hikari_string_free(placement->output_name);
+  hikari_free(placement);
+}
+
+void
+hikari_placement_store(struct hikari_output *output)
+{
+  const char *output_name = output->wlr_output->name;
+  struct hikari_workspace *workspace = output->workspace;
+  struct hikari_placement *placement = find_placement(output_name);
+
+  if (placement != NULL) {
+    destroy_placement(placement);
+  }
+
+  placement = hikari_malloc(sizeof(struct hikari_placement));
+  placement->output_name = hikari_string_dup(output_name);
+  placement->sheet_nr = workspace->sheet->nr;
+  placement->alternate_sheet_nr = workspace->alternate_sheet->nr;
+  placement->splits =
+      hikari_calloc(HIKARI_NR_OF_SHEETS, sizeof(struct hikari_split *));
+
+  for (int i = 0; i < HIKARI_NR_OF_SHEETS; i++) {
+    struct hikari_sheet *sheet = &workspace->sheets[i];
+
+    if (sheet->layout != NULL && !wl_list_empty(&sheet->views)) {
+      placement->splits[i] = hikari_split_copy(sheet->layout->split);
+    }
+  }
+
+  wl_list_init(&placement->views);
+  wl_list_insert(&hikari_server.placements, &placement->server_placements);
+
+  for (int i = 0; i < HIKARI_NR_OF_SHEETS; i++) {
+    struct hikari_sheet *sheet = &workspace->sheets[i];
+    struct hikari_view *view;
+    wl_list_for_each (view, &sheet->views, sheet_views) {
+      if (view->placement != NULL) {
+        continue;
+      }
+
+      struct hikari_view_placement *view_placement =
+          hikari_malloc(sizeof(struct hikari_view_placement));
+
+      view_placement->view = view;
+      view_placement->sheet_nr = sheet->nr;
+      view_placement->geometry = view->geometry;
+
+      wl_list_insert(placement->views.prev, &view_placement->placement_views);
+      view->placement = view_placement;
+    }
+  }
+}
+
+// layouts only apply to the sheet a workspace displays, this shows a sheet
+// without touching the alternate sheet or notifying IPC clients
+static void
+display_sheet(struct hikari_workspace *workspace, struct hikari_sheet *sheet)
+{
+  hikari_workspace_clear(workspace);
+
+  workspace->sheet = sheet;
+
+  hikari_sheet_show(&workspace->sheets[0]);
+
+  if (sheet->nr != 0) {
+    hikari_sheet_show(sheet);
+  }
+}
+
+static void
+add_source(struct hikari_sheet **sources,
+    int *nr_of_sources,
+    struct hikari_sheet *sheet)
+{
+  for (int i = 0; i < *nr_of_sources; i++) {
+    if (sources[i] == sheet) {
+      return;
+    }
+  }
+
+  sources[(*nr_of_sources)++] = sheet;
+}
+
+void
+hikari_placement_restore(struct hikari_output *output)
+{
+  struct hikari_placement *placement =
+      find_placement(output->wlr_output->name);
+
+  if (placement == NULL) {
+    return;
+  }
+
+  struct hikari_workspace *workspace = output->workspace;
+  struct hikari_sheet *sheets = workspace->sheets;
+  struct hikari_sheet *sheet = &sheets[placement->sheet_nr];
+  struct hikari_sheet **sources = hikari_calloc(
+      wl_list_length(&placement->views) + 1, sizeof(struct hikari_sheet *));
+  int nr_of_sources = 0;
+
+  workspace->sheet = sheet;
+  workspace->alternate_sheet = &sheets[placement->alternate_sheet_nr];
+
+  struct hikari_view_placement *view_placement, *view_placement_temp;
+  wl_list_for_each_reverse_safe (view_placement,
+      view_placement_temp,
+      &placement->views,
+      placement_views) {
+    struct hikari_view *view = view_placement->view;
+    struct hikari_sheet *source = view->sheet;
+    bool retile = placement->splits[view_placement->sheet_nr] != NULL;
+
+    if (source->layout != NULL && source->workspace != workspace &&
+        source->workspace->output != hikari_server.noop_output) {
+      add_source(sources, &nr_of_sources, source);
+    }
+
+    if (!hikari_view_is_hidden(view)) {
+      hikari_view_damage_whole(view);
+    }
+
+    hikari_view_evacuate(view, &sheets[view_placement->sheet_nr], retile);
+
+    if (!retile) {
+      hikari_view_restore_geometry(view, &view_placement->geometry);
+    }
+  }
+
+  bool displayed = false;
+  for (int i = 0; i < HIKARI_NR_OF_SHEETS; i++) {
+    if (placement->splits[i] != NULL && &sheets[i] != sheet) {
+      display_sheet(workspace, &sheets[i]);
+      hikari_sheet_retile(&sheets[i], placement->splits[i]);
+      displayed = true;
+    }
+  }
+
+  if (displayed) {
+    display_sheet(workspace, sheet);
+  }
+
+  if (placement->splits[sheet->nr] != NULL) {
+    hikari_sheet_retile(sheet, placement->splits[sheet->nr]);
+  }
+
+  // close the gaps the views left behind on the output they return from
+  for (int i = 0; i < nr_of_sources; i++) {
+    struct hikari_sheet *source = sources[i];
+
+    if (source->layout != NULL && source == source->workspace->sheet) {
+      hikari_sheet_retile(source, source->layout->split);
+    }
+  }
+
+  hikari_free(sources);
+
+  hikari_output_damage_whole(output);
+
+  destroy_placement(placement);
+}
+
+void
+hikari_placement_forget(struct hikari_view *view)
+{
+  struct hikari_view_placement *view_placement = view->placement;
+
+  if (view_placement == NULL) {
+    return;
+  }
+
+  wl_list_remove(&view_placement->placement_views);
+  hikari_free(view_placement);
+
+  view->placement = NULL;
+}
+
+void
+hikari_placements_fini(void)
+{
+  struct hikari_placement *placement, *placement_temp;
+  wl_list_for_each_safe (placement,
+      placement_temp,
+      &hikari_server.placements,
+      server_placements) {
+    destroy_placement(placement);
+  }
+}
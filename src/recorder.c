@@ -0,0 +1,384 @@
+#include <hikari/recorder.h>
+
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+
+#include <wlr/backend/headless.h>
+#include <wlr/backend/multi.h>
+#include <wlr/types/wlr_input_device.h>
+#include <wlr/types/wlr_keyboard.h>
+#include <wlr/types/wlr_pointer.h>
+
+#include <hikari/memory.h>
+#include <hikari/server.h>
+
+static const char hikari_recorder_magic[8] = "HKRREC01";
+
+static uint64_t
+elapsed_nsec(struct timespec *start)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  return (now.tv_sec - start->tv_sec) * 1000000000ULL + now.tv_nsec -
+         start->tv_nsec;
+}
+
+static uint32_t
+now_msec(void)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  return now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+static double
+timeval_sec(struct timeval *tv)
+{
+  return tv->tv_sec + tv->tv_usec / 1000000.0;
+}
+
+static void
+finish_replay(struct hikari_recorder *recorder)
+{
+  struct hikari_recorder_stats *stats = &recorder->stats;
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+
+  fprintf(stderr,
+      "replay finished: %zu events in %.3fs, cpu %.3fs user %.3fs system, "
+      "%lu frames, %.3fms average and %.3fms maximum frame time\n",
+      recorder->nr_of_events,
+      elapsed_nsec(&recorder->start) / 1000000000.0,
+      timeval_sec(&usage.ru_utime),
+      timeval_sec(&usage.ru_stime),
+      stats->frames,
+      stats->frames > 0 ? stats->frame_time / stats->frames / 1000000.0 : 0,
+      stats->max_frame_time / 1000000.0);
+
+  hikari_server_terminate(NULL);
+}
+
+static void
+replay_event(
+    struct hikari_recorder *recorder, struct hikari_recorder_event *event)
+{
+  struct wlr_input_device *pointer = recorder->pointer;
+  uint32_t time_msec = now_msec();
+
+  switch (event->type) {
+    case HIKARI_RECORDER_EVENT_KEY: {
+      struct wlr_event_keyboard_key key = { .time_msec = time_msec,
+        .keycode = event->code,
+        .update_state = true,
+        .state = event->state };
+
+      wlr_keyboard_notify_key(recorder->keyboard->keyboard, &key);
+    } break;
+
+    case HIKARI_RECORDER_EVENT_MOTION: {
+      struct wlr_event_pointer_motion motion = { .device = pointer,
+        .time_msec = time_msec,
+        .delta_x = event->x,
+        .delta_y = event->y,
+        .unaccel_dx = event->x,
+        .unaccel_dy = event->y };
+
+      wl_signal_emit(&pointer->pointer->events.motion, &motion);
+    } break;
+
+    case HIKARI_RECORDER_EVENT_MOTION_ABSOLUTE: {
+      struct wlr_event_pointer_motion_absolute motion = { .device = pointer,
+        .time_msec = time_msec,
+        .x = event->x,
+        .y = event->y };
+
+      wl_signal_emit(&pointer->pointer->events.motion_absolute, &motion);
+    } break;
+
+    case HIKARI_RECORDER_EVENT_BUTTON: {
+      struct wlr_event_pointer_button button = { .device = pointer,
+        .time_msec = time_msec,
+        .button = event->code,
+        .state = event->state };
+
+      wl_signal_emit(&pointer->pointer->events.button, &button);
+    } break;
+
+    case HIKARI_RECORDER_EVENT_AXIS: {
+      struct wlr_event_pointer_axis axis = { .device = pointer,
+        .time_msec = time_msec,
+        .source = event->source,
+        .orientation = event->state,
+        .delta = event->x,
+        .delta_discrete = event->discrete };
+
+      wl_signal_emit(&pointer->pointer->events.axis, &axis);
+    } break;
+
+    case HIKARI_RECORDER_EVENT_FRAME:
+      wl_signal_emit(&pointer->pointer->events.frame, pointer->pointer);
+      break;
+
+    default:
+      break;
+  }
+}
+
+static int
+replay_handler(void *data)
+{
+  struct hikari_recorder *recorder = data;
+  struct hikari_recorder_event *events = recorder->events;
+
+  if (recorder->next_event == 0) {
+    clock_gettime(CLOCK_MONOTONIC, &recorder->start);
+    recorder->stats = (struct hikari_recorder_stats){ 0 };
+  }
+
+  uint32_t elapsed = elapsed_nsec(&recorder->start) / 1000000 + events[0].time;
+
+  while (recorder->next_event < recorder->nr_of_events &&
+         events[recorder->next_event].time <= elapsed) {
+    replay_event(recorder, &events[recorder->next_event++]);
+  }
+
+  if (recorder->next_event == recorder->nr_of_events) {
+    finish_replay(recorder);
+  } else {
+    wl_event_source_timer_update(
+        recorder->timer, events[recorder->next_event].time - elapsed);
+  }
+
+  return 0;
+}
+
+static bool
+load_replay(struct hikari_recorder *recorder, const char *path)
+{
+  FILE *file = fopen(path, "r");
+  bool success = false;
+  char magic[sizeof(hikari_recorder_magic)];
+  struct stat st;
+
+  if (file == NULL) {
+    fprintf(stderr, "replay error: could not open \"%s\"\n", path);
+    return false;
+  }
+
+  if (fread(magic, sizeof(magic), 1, file) != 1 ||
+      memcmp(magic, hikari_recorder_magic, sizeof(magic)) ||
+      fstat(fileno(file), &st) == -1) {
+    fprintf(stderr, "replay error: \"%s\" is not a recording\n", path);
+    goto done;
+  }
+
+  size_t nr_of_events =
+      (st.st_size - sizeof(magic)) / sizeof(struct hikari_recorder_event);
+
+  if (nr_of_events == 0) {
+    fprintf(stderr, "replay error: \"%s\" contains no events\n", path);
+    goto done;
+  }
+
+  recorder->events =
+      hikari_calloc(nr_of_events, sizeof(struct hikari_recorder_event));
+
+  if (fread(recorder->events,
+          sizeof(struct hikari_recorder_event),
+          nr_of_events,
+          file) != nr_of_events) {
+    fprintf(stderr, "replay error: could not read \"%s\"\n", path);
+    hikari_free(recorder->events);
+    recorder->events = NULL;
+    goto done;
+  }
+
+  recorder->nr_of_events = nr_of_events;
+  success = true;
+
+done:
+  fclose(file);
+
+  return success;
+}
+
+static void
+init_replay(struct hikari_recorder *recorder,
+    struct wl_display *display,
+    struct wlr_backend *backend,
+    const char *path)
+{
+  if (!wlr_backend_is_multi(backend)) {
+    fprintf(stderr, "replay error: backend does not support extra inputs\n");
+    return;
+  }
+
+  if (!load_replay(recorder, path)) {
+    return;
+  }
+
+  recorder->backend = wlr_headless_backend_create(display);
+  recorder->keyboard = wlr_headless_add_input_device(
+      recorder->backend, WLR_INPUT_DEVICE_KEYBOARD);
+  recorder->pointer = wlr_headless_add_input_device(
+      recorder->backend, WLR_INPUT_DEVICE_POINTER);
+
+  wlr_multi_backend_add(backend, recorder->backend);
+
+  recorder->timer = wl_event_loop_add_timer(
+      wl_display_get_event_loop(display), replay_handler, recorder);
+  wl_event_source_timer_update(recorder->timer, HIKARI_RECORDER_REPLAY_DELAY);
+}
+
+static void
+init_record(struct hikari_recorder *recorder, const char *path)
+{
+  recorder->file = fopen(path, "w");
+
+  if (recorder->file == NULL) {
+    fprintf(stderr, "record error: could not open \"%s\"\n", path);
+    return;
+  }
+
+  fwrite(
+      hikari_recorder_magic, sizeof(hikari_recorder_magic), 1, recorder->file);
+  clock_gettime(CLOCK_MONOTONIC, &recorder->start);
+}
+
+void
+hikari_recorder_init(struct hikari_recorder *recorder,
+    struct wl_display *display,
+    struct wlr_backend *backend)
+{
+  recorder->file = NULL;
+  recorder->events = NULL;
+  recorder->nr_of_events = 0;
+  recorder->next_event = 0;
+  recorder->timer = NULL;
+  recorder->backend = NULL;
+  recorder->keyboard = NULL;
+  recorder->pointer = NULL;
+  recorder->stats = (struct hikari_recorder_stats){ 0 };
+
+  const char *replay_path = getenv("HIKARI_REPLAY");
+  const char *record_path = getenv("HIKARI_RECORD");
+
+  if (replay_path != NULL) {
+    init_replay(recorder, display, backend, replay_path);
+  } else if (record_path != NULL) {
+    init_record(recorder, record_path);
+  }
+}
+
+void
+hikari_recorder_fini(struct hikari_recorder *recorder)
+{
+  if (recorder->file != NULL) {
+    fclose(recorder->file);
+    recorder->file = NULL;
+  }
+
+  if (recorder->timer != NULL) {
+    wl_event_source_remove(recorder->timer);
+    recorder->timer = NULL;
+  }
+
+  hikari_free(recorder->events);
+  recorder->events = NULL;
+}
+
+void
+hikari_recorder_record(
+    struct hikari_recorder *recorder, struct hikari_recorder_event *event)
+{
+  if (recorder->file == NULL) {
+    return;
+  }
+
+  event->time = elapsed_nsec(&recorder->start) / 1000000;
+
+  fwrite(event, sizeof(struct hikari_recorder_event), 1, recorder->file);
+}
+
+void
+hikari_recorder_key(
+    struct hikari_recorder *recorder, struct wlr_event_keyboard_key *event)
+{
+  struct hikari_recorder_event recorder_event = {
+    .type = HIKARI_RECORDER_EVENT_KEY,
+    .state = event->state,
+    .code = event->keycode
+  };
+
+  hikari_recorder_record(recorder, &recorder_event);
+}
+
+void
+hikari_recorder_motion(
+    struct hikari_recorder *recorder, struct wlr_event_pointer_motion *event)
+{
+  struct hikari_recorder_event recorder_event = {
+    .type = HIKARI_RECORDER_EVENT_MOTION,
+    .x = event->delta_x,
+    .y = event->delta_y
+  };
+
+  hikari_recorder_record(recorder, &recorder_event);
+}
+
+void
+hikari_recorder_motion_absolute(struct hikari_recorder *recorder,
+    struct wlr_event_pointer_motion_absolute *event)
+{
+  struct hikari_recorder_event recorder_event = {
+    .type = HIKARI_RECORDER_EVENT_MOTION_ABSOLUTE, .x = event->x, .y = event->y
+  };
+
+  hikari_recorder_record(recorder, &recorder_event);
+}
+
+void
+hikari_recorder_button(
+    struct hikari_recorder *recorder, struct wlr_event_pointer_button *event)
+{
+  struct hikari_recorder_event recorder_event = {
+    .type = HIKARI_RECORDER_EVENT_BUTTON,
+    .state = event->state,
+    .code = event->button
+  };
+
+  hikari_recorder_record(recorder, &recorder_event);
+}
+
+void
+hikari_recorder_axis(
+    struct hikari_recorder *recorder, struct wlr_event_pointer_axis *event)
+{
+  struct hikari_recorder_event recorder_event = {
+    .type = HIKARI_RECORDER_EVENT_AXIS,
+    .state = event->orientation,
+    .source = event->source,
+    .discrete = event->delta_discrete,
+    .x = event->delta
+  };
+
+  hikari_recorder_record(recorder, &recorder_event);
+}
+
+void
+hikari_recorder_frame_time(
+    struct hikari_recorder *recorder, struct timespec *start)
+{
+  struct hikari_recorder_stats *stats = &recorder->stats;
+  uint64_t frame_time = elapsed_nsec(start);
+
+  stats->frames++;
+  stats->frame_time += frame_time;
+
+  if (frame_time > stats->max_frame_time) {
+    stats->max_frame_time = frame_time;
+  }
+}
@@ -1,11 +1,18 @@
 #include <hikari/renderer.h>
 
 #include <assert.h>
+#include <string.h>
 
-#include <hikari/color.h>
+#include <drm_fourcc.h>
+
+#include <hikari/animation.h>
+#include <hikari/damage_overlay.h>
+#include <hikari/damage_ring.h>
 #include <hikari/geometry.h>
+#include <hikari/memory.h>
 #include <hikari/output.h>
 #include <hikari/renderer.h>
+#include <hikari/trace.h>
 #include <hikari/view.h>
 
 #ifdef HAVE_XWAYLAND
@@ -14,18 +21,20 @@
 #endif
 
 #include <wlr/backend.h>
+#include <wlr/backend/headless.h>
 #include <wlr/render/wlr_renderer.h>
 #include <wlr/types/wlr_matrix.h>
 #include <wlr/types/wlr_output.h>
 #include <wlr/types/wlr_output_damage.h>
+#include <wlr/util/box.h>
 #include <wlr/util/region.h>
 
 #ifdef HAVE_XWAYLAND
 #include <wlr/xwayland.h>
 #endif
 
-static inline void
-renderer_scissor(struct wlr_output *wlr_output,
+void
+hikari_renderer_scissor(struct wlr_output *wlr_output,
     struct wlr_renderer *renderer,
     pixman_box32_t *rect)
 {
@@ -36,6 +45,15 @@ renderer_scissor(struct wlr_output *wlr_output,
     .width = rect->x2 - rect->x1,
     .height = rect->y2 - rect->y1 };
 
+  // damage is tracked in output coordinates, scissoring happens on the
+  // buffer
+  int width, height;
+  wlr_output_transformed_resolution(wlr_output, &width, &height);
+
+  enum wl_output_transform transform =
+      wlr_output_transform_invert(wlr_output->transform);
+  wlr_box_transform(&box, &box, transform, width, height);
+
   wlr_renderer_scissor(renderer, &box);
 }
 
@@ -55,6 +73,10 @@ rect_render(float color[static 4],
     goto buffer_damage_finish;
   }
 
+  if (renderer->overlay != NULL) {
+    hikari_damage_overlay_account(renderer->overlay, &damage);
+  }
+
   struct wlr_renderer *wlr_renderer = renderer->wlr_renderer;
   struct wlr_output *wlr_output = renderer->wlr_output;
   assert(renderer);
@@ -66,7 +88,7 @@ rect_render(float color[static 4],
   int nrects;
   pixman_box32_t *rects = pixman_region32_rectangles(&damage, &nrects);
   for (int i = 0; i < nrects; i++) {
-    renderer_scissor(wlr_output, wlr_renderer, &rects[i]);
+    hikari_renderer_scissor(wlr_output, wlr_renderer, &rects[i]);
     wlr_render_quad_with_matrix(wlr_renderer, color, matrix);
   }
 
@@ -126,7 +148,7 @@ render_border(struct hikari_border *border, struct hikari_renderer *renderer)
   int nrects;
   pixman_box32_t *rects = pixman_region32_rectangles(&damage, &nrects);
   for (int i = 0; i < nrects; i++) {
-    renderer_scissor(wlr_output, wlr_renderer, &rects[i]);
+    hikari_renderer_scissor(wlr_output, wlr_renderer, &rects[i]);
     rect_render(color, &border->top, renderer);
     rect_render(color, &border->bottom, renderer);
     rect_render(color, &border->left, renderer);
@@ -141,12 +163,15 @@ static void
 render_indicator_bar(struct hikari_indicator_bar *indicator_bar,
     struct hikari_renderer *renderer)
 {
+  struct wlr_renderer *wlr_renderer = renderer->wlr_renderer;
+
+  hikari_indicator_bar_refresh(indicator_bar, wlr_renderer);
+
   if (indicator_bar->texture == NULL) {
     return;
   }
 
   struct wlr_box *geometry = renderer->geometry;
-  struct wlr_renderer *wlr_renderer = renderer->wlr_renderer;
   struct wlr_output *wlr_output = renderer->wlr_output;
 
   float matrix[9];
@@ -246,7 +271,7 @@ render_indicator_frame(struct hikari_indicator_frame *indicator_frame,
   int nrects;
   pixman_box32_t *rects = pixman_region32_rectangles(&damage, &nrects);
   for (int i = 0; i < nrects; i++) {
-    renderer_scissor(wlr_output, wlr_renderer, &rects[i]);
+    hikari_renderer_scissor(wlr_output, wlr_renderer, &rects[i]);
     wlr_render_quad_with_matrix(wlr_renderer, color, top_matrix);
     wlr_render_quad_with_matrix(wlr_renderer, color, bottom_matrix);
     wlr_render_quad_with_matrix(wlr_renderer, color, left_matrix);
@@ -265,18 +290,10 @@ clear_output(struct hikari_renderer *renderer)
   struct wlr_output *wlr_output = renderer->wlr_output;
   pixman_region32_t *damage = renderer->damage;
 
-#ifndef NDEBUG
-  if (hikari_server.track_damage) {
-    float damage_color[4];
-    hikari_color_convert(damage_color, 0x000000);
-    wlr_renderer_clear(wlr_renderer, damage_color);
-  }
-#endif
-
   int nrects;
   pixman_box32_t *rects = pixman_region32_rectangles(damage, &nrects);
   for (int i = 0; i < nrects; ++i) {
-    renderer_scissor(wlr_output, wlr_renderer, &rects[i]);
+    hikari_renderer_scissor(wlr_output, wlr_renderer, &rects[i]);
     wlr_renderer_clear(wlr_renderer, clear_color);
   }
 }
@@ -288,7 +305,9 @@ renderer_end(struct hikari_output *output, struct hikari_renderer *renderer)
   struct wlr_output *wlr_output = renderer->wlr_output;
 
   wlr_renderer_scissor(wlr_renderer, NULL);
-  wlr_output_render_software_cursors(wlr_output, NULL);
+  if (wlr_output->hardware_cursor == NULL) {
+    wlr_output_render_software_cursors(wlr_output, NULL);
+  }
   wlr_renderer_end(wlr_renderer);
 
   int width, height;
@@ -303,37 +322,47 @@ renderer_end(struct hikari_output *output, struct hikari_renderer *renderer)
       &frame_damage, &output->damage->current, transform, width, height);
 
   wlr_output_set_damage(wlr_output, &frame_damage);
-  pixman_region32_fini(&frame_damage);
 
-  wlr_output_commit(wlr_output);
+  pixman_region32_copy(&frame_damage, &output->damage->current);
+
+  if (wlr_output_commit(wlr_output)) {
+    hikari_damage_ring_push(&output->damage_ring, &frame_damage);
+  }
+
+  pixman_region32_fini(&frame_damage);
 }
 
 static inline void
 render_texture(struct wlr_texture *texture,
-    struct wlr_output *output,
-    pixman_region32_t *damage,
-    struct wlr_renderer *renderer,
+    struct hikari_renderer *renderer,
     const float matrix[static 9],
     struct wlr_box *box,
     float alpha)
 {
+  struct wlr_output *wlr_output = renderer->wlr_output;
+  struct wlr_renderer *wlr_renderer = renderer->wlr_renderer;
+
   pixman_region32_t local_damage;
   pixman_region32_init(&local_damage);
   pixman_region32_union_rect(
       &local_damage, &local_damage, box->x, box->y, box->width, box->height);
 
-  pixman_region32_intersect(&local_damage, &local_damage, damage);
+  pixman_region32_intersect(&local_damage, &local_damage, renderer->damage);
 
   bool damaged = pixman_region32_not_empty(&local_damage);
   if (!damaged) {
     goto damage_finish;
   }
 
+  if (renderer->overlay != NULL) {
+    hikari_damage_overlay_account(renderer->overlay, &local_damage);
+  }
+
   int nrects;
   pixman_box32_t *rects = pixman_region32_rectangles(&local_damage, &nrects);
   for (int i = 0; i < nrects; ++i) {
-    renderer_scissor(output, renderer, &rects[i]);
-    wlr_render_texture_with_matrix(renderer, texture, matrix, alpha);
+    hikari_renderer_scissor(wlr_output, wlr_renderer, &rects[i]);
+    wlr_render_texture_with_matrix(wlr_renderer, texture, matrix, alpha);
   }
 
 damage_finish:
@@ -354,7 +383,6 @@ render_surface(struct wlr_surface *surface, int sx, int sy, void *data)
   struct hikari_renderer *renderer = data;
   struct wlr_box *geometry = renderer->geometry;
   struct wlr_output *wlr_output = renderer->wlr_output;
-  struct wlr_renderer *wlr_renderer = renderer->wlr_renderer;
 
   double ox = geometry->x + sx;
   double oy = geometry->y + sy;
@@ -371,8 +399,47 @@ render_surface(struct wlr_surface *surface, int sx, int sy, void *data)
   wlr_matrix_project_box(
       matrix, &box, transform, 0, wlr_output->transform_matrix);
 
-  render_texture(
-      texture, wlr_output, renderer->damage, wlr_renderer, matrix, &box, 1);
+  render_texture(texture, renderer, matrix, &box, 1);
+}
+
+struct hikari_scaled_data {
+  struct hikari_renderer *renderer;
+  struct wlr_box *geometry;
+  double scale_x;
+  double scale_y;
+};
+
+static void
+render_scaled_surface(struct wlr_surface *surface, int sx, int sy, void *data)
+{
+  assert(surface != NULL);
+
+  struct wlr_texture *texture = wlr_surface_get_texture(surface);
+
+  if (texture == NULL) {
+    return;
+  }
+
+  struct hikari_scaled_data *scaled_data = data;
+  struct hikari_renderer *renderer = scaled_data->renderer;
+  struct wlr_box *geometry = scaled_data->geometry;
+  struct wlr_output *wlr_output = renderer->wlr_output;
+  double scale_x = scaled_data->scale_x * wlr_output->scale;
+  double scale_y = scaled_data->scale_y * wlr_output->scale;
+
+  struct wlr_box box = { .x = geometry->x * wlr_output->scale + sx * scale_x,
+    .y = geometry->y * wlr_output->scale + sy * scale_y,
+    .width = surface->current.width * scale_x,
+    .height = surface->current.height * scale_y };
+
+  float matrix[9];
+  enum wl_output_transform transform =
+      wlr_output_transform_invert(surface->current.transform);
+
+  wlr_matrix_project_box(
+      matrix, &box, transform, 0, wlr_output->transform_matrix);
+
+  render_texture(texture, renderer, matrix, &box, 1);
 }
 
 static inline void
@@ -386,7 +453,6 @@ render_background(struct hikari_renderer *renderer, float alpha)
 
   float matrix[9];
   struct wlr_output *wlr_output = output->wlr_output;
-  struct wlr_renderer *wlr_renderer = renderer->wlr_renderer;
 
   struct wlr_box geometry = { .x = 0, .y = 0 };
   wlr_output_transformed_resolution(
@@ -394,13 +460,7 @@ render_background(struct hikari_renderer *renderer, float alpha)
 
   wlr_matrix_project_box(matrix, &geometry, 0, 0, wlr_output->transform_matrix);
 
-  render_texture(output->background,
-      wlr_output,
-      renderer->damage,
-      wlr_renderer,
-      matrix,
-      &geometry,
-      alpha);
+  render_texture(output->background, renderer, matrix, &geometry, alpha);
 }
 
 #ifdef HAVE_LAYERSHELL
@@ -416,9 +476,33 @@ render_layer(struct wl_list *layers, struct hikari_renderer *renderer)
 }
 #endif
 
+static void
+render_animated_view(struct hikari_renderer *renderer, struct hikari_view *view)
+{
+  struct hikari_animation *animation = view->animation;
+  struct wlr_box *geometry = hikari_view_geometry(view);
+
+  if (geometry->width == 0 || geometry->height == 0) {
+    return;
+  }
+
+  struct hikari_scaled_data scaled_data = { .renderer = renderer,
+    .geometry = &animation->box,
+    .scale_x = (double)animation->box.width / geometry->width,
+    .scale_y = (double)animation->box.height / geometry->height };
+
+  hikari_node_for_each_surface(
+      (struct hikari_node *)view, render_scaled_surface, &scaled_data);
+}
+
 static inline void
 render_view(struct hikari_renderer *renderer, struct hikari_view *view)
 {
+  if (view->animation != NULL) {
+    render_animated_view(renderer, view);
+    return;
+  }
+
   renderer->geometry = hikari_view_border_geometry(view);
 
   if (hikari_view_wants_border(view)) {
@@ -460,9 +544,17 @@ render_workspace(struct hikari_renderer *renderer)
   render_layer(&output->layers[ZWLR_LAYER_SHELL_V1_LAYER_BOTTOM], renderer);
 #endif
 
-  struct hikari_view *view;
-  wl_list_for_each_reverse (view, &output->workspace->views, workspace_views) {
-    render_view(renderer, view);
+  struct hikari_workspace *workspace = output->workspace;
+  struct hikari_stacking *stacking = &workspace->stacking;
+  hikari_stacking_update(stacking, &workspace->views);
+
+  for (int i = stacking->nr_of_views - 1; i >= 0; i--) {
+    struct hikari_view *view = stacking->views[i];
+
+    if (view->animation != NULL ||
+        hikari_stacking_may_intersect(stacking, i, renderer->damage)) {
+      render_view(renderer, view);
+    }
   }
 
 #ifdef HAVE_LAYERSHELL
@@ -483,15 +575,85 @@ render_overlay(struct hikari_renderer *renderer)
 }
 #endif
 
+static void
+validate_output(struct hikari_output *output, struct hikari_renderer *renderer)
+{
+  struct wlr_output *wlr_output = renderer->wlr_output;
+  struct wlr_renderer *wlr_renderer = renderer->wlr_renderer;
+  pixman_region32_t *damage = renderer->damage;
+
+  uint32_t stride = wlr_output->width * 4;
+  size_t size = stride * wlr_output->height;
+  unsigned char *partial = hikari_malloc(2 * size);
+  unsigned char *full = partial + size;
+
+  wlr_renderer_scissor(wlr_renderer, NULL);
+  if (!wlr_renderer_read_pixels(wlr_renderer,
+          DRM_FORMAT_ARGB8888,
+          NULL,
+          stride,
+          wlr_output->width,
+          wlr_output->height,
+          0,
+          0,
+          0,
+          0,
+          partial)) {
+    goto done;
+  }
+
+  int width, height;
+  wlr_output_transformed_resolution(wlr_output, &width, &height);
+
+  pixman_region32_t full_damage;
+  pixman_region32_init_rect(&full_damage, 0, 0, width, height);
+
+  renderer->damage = &full_damage;
+  clear_output(renderer);
+  hikari_server.mode->render(renderer);
+  renderer->damage = damage;
+
+  pixman_region32_fini(&full_damage);
+
+  wlr_renderer_scissor(wlr_renderer, NULL);
+  if (!wlr_renderer_read_pixels(wlr_renderer,
+          DRM_FORMAT_ARGB8888,
+          NULL,
+          stride,
+          wlr_output->width,
+          wlr_output->height,
+          0,
+          0,
+          0,
+          0,
+          full)) {
+    goto done;
+  }
+
+  hikari_damage_ring_validated(
+      &output->damage_ring, wlr_output->name, !memcmp(partial, full, size));
+
+done:
+  hikari_free(partial);
+}
+
 static inline void
 render_output(struct hikari_output *output, pixman_region32_t *damage)
 {
+  HIKARI_TRACE_SCOPE("render_output");
+
   struct wlr_output *wlr_output = output->wlr_output;
   struct wlr_renderer *wlr_renderer = wlr_output->renderer;
 
-  struct hikari_renderer renderer = {
-    .wlr_output = wlr_output, .wlr_renderer = wlr_renderer, .damage = damage
-  };
+  struct hikari_renderer renderer = { .wlr_output = wlr_output,
+    .wlr_renderer = wlr_renderer,
+    .damage = damage,
+    .overlay = NULL };
+
+  if (hikari_server.track_damage) {
+    renderer.overlay = &output->damage_overlay;
+    hikari_damage_overlay_begin(renderer.overlay);
+  }
 
   wlr_renderer_begin(wlr_renderer, wlr_output->width, wlr_output->height);
 
@@ -499,6 +661,14 @@ render_output(struct hikari_output *output, pixman_region32_t *damage)
     clear_output(&renderer);
 
     hikari_server.mode->render(&renderer);
+
+    if (renderer.overlay != NULL) {
+      hikari_damage_overlay_render(renderer.overlay, &renderer);
+    } else if (output->damage_ring.mode == HIKARI_DAMAGE_RING_MODE_VALIDATE &&
+               !output->damage_ring.full &&
+               wlr_output_is_headless(wlr_output)) {
+      validate_output(output, &renderer);
+    }
   }
 
   renderer_end(output, &renderer);
@@ -533,9 +703,12 @@ frame_done(struct hikari_output *output)
   struct timespec now;
   clock_gettime(CLOCK_MONOTONIC, &now);
 
-  wl_list_for_each_reverse (view, &output->views, output_views) {
-    hikari_node_for_each_surface(
-        (struct hikari_node *)view, send_frame_done, &now);
+  if (!hikari_server_in_overview_mode() ||
+      !hikari_overview_mode_throttles(&hikari_server.overview_mode, output)) {
+    wl_list_for_each_reverse (view, &output->views, output_views) {
+      hikari_node_for_each_surface(
+          (struct hikari_node *)view, send_frame_done, &now);
+    }
   }
 
 #ifdef HAVE_XWAYLAND
@@ -558,25 +731,56 @@ frame_done(struct hikari_output *output)
 void
 hikari_renderer_damage_frame_handler(struct wl_listener *listener, void *data)
 {
+  HIKARI_TRACE_SCOPE("damage_frame");
+
   struct hikari_output *output =
       wl_container_of(listener, output, damage_frame);
 
+#ifdef HAVE_IDLE
+  if (hikari_idle_is_standby(&hikari_server.idle)) {
+    return;
+  }
+#endif
+
+  if (!wl_list_empty(&hikari_server.animations)) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    hikari_animations_frame(output, &now);
+  }
+
+  struct wlr_output *wlr_output = output->wlr_output;
+  pixman_region32_t *current = &output->damage->current;
+
   pixman_region32_t buffer_damage;
   pixman_region32_init(&buffer_damage);
 
-  bool needs_frame;
-  if (!wlr_output_damage_attach_render(
-          output->damage, &needs_frame, &buffer_damage)) {
+  int buffer_age;
+  if (!wlr_output_attach_render(wlr_output, &buffer_age)) {
     goto render_done;
   }
 
-  if (!needs_frame) {
-    wlr_output_rollback(output->wlr_output);
+  if (!wlr_output->needs_frame && !pixman_region32_not_empty(current)) {
+    wlr_output_rollback(wlr_output);
     goto render_done;
   }
 
+  int width, height;
+  wlr_output_transformed_resolution(wlr_output, &width, &height);
+
+  hikari_damage_ring_buffer_damage(
+      &output->damage_ring, current, buffer_age, width, height, &buffer_damage);
+
+#ifdef HAVE_RECORD
+  struct timespec start;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+#endif
+
   render_output(output, &buffer_damage);
 
+#ifdef HAVE_RECORD
+  hikari_recorder_frame_time(&hikari_server.recorder, &start);
+#endif
+
 render_done:
   pixman_region32_fini(&buffer_damage);
 
@@ -652,9 +856,16 @@ render_cycling_workspace(
   render_layer(&output->layers[ZWLR_LAYER_SHELL_V1_LAYER_BOTTOM], renderer);
 #endif
 
-  struct hikari_view *view;
-  wl_list_for_each_reverse (view, &output->workspace->views, workspace_views) {
-    if (view != focus_view) {
+  struct hikari_workspace *workspace = output->workspace;
+  struct hikari_stacking *stacking = &workspace->stacking;
+  hikari_stacking_update(stacking, &workspace->views);
+
+  for (int i = stacking->nr_of_views - 1; i >= 0; i--) {
+    struct hikari_view *view = stacking->views[i];
+
+    if (view != focus_view &&
+        (view->animation != NULL ||
+            hikari_stacking_may_intersect(stacking, i, renderer->damage))) {
       render_view(renderer, view);
     }
   }
@@ -699,6 +910,45 @@ hikari_renderer_normal_mode(struct hikari_renderer *renderer)
 #endif
 }
 
+void
+hikari_renderer_find_mode(struct hikari_renderer *renderer)
+{
+  struct hikari_output *output = renderer->wlr_output->data;
+
+  render_background(renderer, 1);
+  render_workspace(renderer);
+
+#ifdef HAVE_LAYERSHELL
+  render_overlay(renderer);
+#endif
+
+  struct hikari_find_mode *mode = &hikari_server.find_mode;
+
+  assert(mode == (struct hikari_find_mode *)hikari_server.mode);
+
+  if (hikari_server.workspace->output != output) {
+    return;
+  }
+
+  struct wlr_box origin;
+  struct wlr_box geometry;
+  hikari_find_mode_origin(output, &origin);
+
+  renderer->geometry = &geometry;
+
+  geometry.x = origin.x + 5;
+  geometry.y = origin.y + mode->prompt.offset;
+  render_indicator_bar(&mode->prompt, renderer);
+
+  for (int i = 0; i < HIKARI_FIND_MODE_MAX_RESULTS; i++) {
+    struct hikari_indicator_bar *entry = &mode->entries[i];
+
+    geometry.x = origin.x + 5;
+    geometry.y = origin.y + entry->offset;
+    render_indicator_bar(entry, renderer);
+  }
+}
+
 void
 hikari_renderer_group_assign_mode(struct hikari_renderer *renderer)
 {
@@ -993,3 +1243,77 @@ hikari_renderer_mark_select_mode(struct hikari_renderer *renderer)
 {
   render_default_workspace(renderer);
 }
+
+static inline void
+render_thumbnail_frame(
+    struct hikari_thumbnail *thumbnail, struct hikari_renderer *renderer)
+{
+  struct wlr_box *geometry = &thumbnail->geometry;
+  float *color = hikari_configuration->indicator_selected;
+  const int width = 3;
+
+  struct wlr_box top = { .x = geometry->x - width,
+    .y = geometry->y - width,
+    .width = geometry->width + 2 * width,
+    .height = width };
+  struct wlr_box bottom = top;
+  bottom.y = geometry->y + geometry->height;
+
+  struct wlr_box left = { .x = geometry->x - width,
+    .y = geometry->y,
+    .width = width,
+    .height = geometry->height };
+  struct wlr_box right = left;
+  right.x = geometry->x + geometry->width;
+
+  rect_render(color, &top, renderer);
+  rect_render(color, &bottom, renderer);
+  rect_render(color, &left, renderer);
+  rect_render(color, &right, renderer);
+}
+
+void
+hikari_renderer_overview_mode(struct hikari_renderer *renderer)
+{
+  struct hikari_output *output = renderer->wlr_output->data;
+  struct hikari_overview_mode *mode = &hikari_server.overview_mode;
+
+  assert(mode == (struct hikari_overview_mode *)hikari_server.mode);
+
+  if (mode->output != output) {
+    render_default_workspace(renderer);
+    return;
+  }
+
+  render_background(renderer, 0.5);
+
+  struct hikari_scaled_data scaled_data = { .renderer = renderer };
+
+  for (int i = 0; i < mode->nr_of_thumbnails; i++) {
+    struct hikari_thumbnail *thumbnail = &mode->thumbnails[i];
+
+    if (i == mode->selected) {
+      render_thumbnail_frame(thumbnail, renderer);
+    }
+
+    scaled_data.geometry = &thumbnail->geometry;
+    scaled_data.scale_x = thumbnail->scale;
+    scaled_data.scale_y = thumbnail->scale;
+    hikari_node_for_each_surface((struct hikari_node *)thumbnail->view,
+        render_scaled_surface,
+        &scaled_data);
+  }
+
+  if (mode->nr_of_thumbnails > 0) {
+    struct wlr_box *geometry = &mode->thumbnails[mode->selected].geometry;
+    struct wlr_box title_geometry = { .x = geometry->x + 5,
+      .y = geometry->y + geometry->height + mode->title.offset };
+
+    renderer->geometry = &title_geometry;
+    render_indicator_bar(&mode->title, renderer);
+  }
+
+#ifdef HAVE_LAYERSHELL
+  render_overlay(renderer);
+#endif
+}
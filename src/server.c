@@ -32,6 +32,7 @@
 #endif
 
 #ifdef HAVE_SCREENCOPY
+#include <wlr/types/wlr_export_dmabuf_v1.h>
 #include <wlr/types/wlr_screencopy_v1.h>
 #endif
 
@@ -45,14 +46,18 @@
 #include <hikari/decoration.h>
 #include <hikari/exec.h>
 #include <hikari/keyboard.h>
+#include <hikari/keymap_cache.h>
 #include <hikari/layout.h>
 #include <hikari/mark.h>
 #include <hikari/memory.h>
 #include <hikari/output.h>
+#include <hikari/placement.h>
 #include <hikari/pointer.h>
 #include <hikari/pointer_config.h>
 #include <hikari/sheet.h>
+#include <hikari/slab.h>
 #include <hikari/switch.h>
+#include <hikari/trace.h>
 #include <hikari/workspace.h>
 #include <hikari/xdg_view.h>
 
@@ -389,9 +394,15 @@ node_at(double lx,
   }
 #endif
 
-  struct hikari_view *view = NULL;
-  wl_list_for_each (view, &output_workspace->views, workspace_views) {
-    node = (struct hikari_node *)view;
+  struct hikari_stacking *stacking = &output_workspace->stacking;
+  hikari_stacking_update(stacking, &output_workspace->views);
+
+  for (int i = 0; i < stacking->nr_of_views; i++) {
+    if (!hikari_stacking_may_contain(stacking, i, ox, oy)) {
+      continue;
+    }
+
+    node = (struct hikari_node *)stacking->views[i];
 
     if (surface_at(node, ox, oy, surface, sx, sy)) {
       return node;
@@ -468,13 +479,13 @@ new_xwayland_surface_handler(struct wl_listener *listener, void *data)
 
   if (wlr_xwayland_surface->override_redirect) {
     struct hikari_xwayland_unmanaged_view *xwayland_unmanaged_view =
-        hikari_malloc(sizeof(struct hikari_xwayland_unmanaged_view));
+        hikari_slab_alloc(&hikari_xwayland_unmanaged_view_slab);
 
     hikari_xwayland_unmanaged_view_init(
         xwayland_unmanaged_view, wlr_xwayland_surface, workspace);
   } else {
     struct hikari_xwayland_view *xwayland_view =
-        hikari_malloc(sizeof(struct hikari_xwayland_view));
+        hikari_slab_alloc(&hikari_xwayland_view_slab);
 
     hikari_xwayland_view_init(xwayland_view, wlr_xwayland_surface, workspace);
   }
@@ -648,7 +659,7 @@ new_xdg_surface_handler(struct wl_listener *listener, void *data)
   }
 
   struct hikari_xdg_view *xdg_view =
-      hikari_malloc(sizeof(struct hikari_xdg_view));
+      hikari_slab_alloc(&hikari_xdg_view_slab);
 
   hikari_xdg_view_init(xdg_view, xdg_surface, server->workspace);
 }
@@ -794,9 +805,7 @@ init_noop_output(struct hikari_server *server)
 static void
 server_init(struct hikari_server *server, char *config_path)
 {
-#ifndef NDEBUG
   server->track_damage = false;
-#endif
   server->shutdown_timer = NULL;
   server->config_path = config_path;
 
@@ -874,6 +883,11 @@ server_init(struct hikari_server *server, char *config_path)
 
 #ifdef HAVE_SCREENCOPY
   wlr_screencopy_manager_v1_create(server->display);
+  wlr_export_dmabuf_manager_v1_create(server->display);
+#endif
+
+#ifdef HAVE_IDLE
+  hikari_idle_init(&server->idle, server->display, server->event_loop);
 #endif
 
 #ifdef HAVE_XWAYLAND
@@ -896,10 +910,17 @@ server_init(struct hikari_server *server, char *config_path)
   wl_list_init(&server->switches);
 
   wl_list_init(&server->groups);
+  hikari_group_trie_init(&server->group_trie);
   wl_list_init(&server->visible_groups);
   wl_list_init(&server->visible_views);
+  wl_list_init(&server->placements);
+  wl_list_init(&server->animations);
+
+  hikari_view_index_init(&server->view_index);
+  hikari_view_table_init(&server->view_table);
 
   hikari_dnd_mode_init(&server->dnd_mode);
+  hikari_find_mode_init(&server->find_mode);
   hikari_group_assign_mode_init(&server->group_assign_mode);
   hikari_input_grab_mode_init(&server->input_grab_mode);
   hikari_layout_select_mode_init(&server->layout_select_mode);
@@ -908,12 +929,29 @@ server_init(struct hikari_server *server, char *config_path)
   hikari_mark_select_mode_init(&server->mark_select_mode);
   hikari_move_mode_init(&server->move_mode);
   hikari_normal_mode_init(&server->normal_mode);
+  hikari_overview_mode_init(&server->overview_mode);
   hikari_resize_mode_init(&server->resize_mode);
   hikari_sheet_assign_mode_init(&server->sheet_assign_mode);
 
   hikari_marks_init();
 
   init_noop_output(server);
+
+#ifdef HAVE_INOTIFY
+  hikari_config_watch_init(&server->config_watch, server->event_loop);
+#endif
+
+#ifdef HAVE_IPC
+  hikari_ipc_init(&server->ipc, server->event_loop, server->socket);
+#endif
+
+#ifdef HAVE_TRACE
+  hikari_trace_init(server->event_loop);
+#endif
+
+#ifdef HAVE_RECORD
+  hikari_recorder_init(&server->recorder, server->display, server->backend);
+#endif
 }
 
 static void
@@ -1020,6 +1058,22 @@ hikari_server_stop(void)
     destroy_shutdown_timer(server);
   }
 
+#ifdef HAVE_INOTIFY
+  hikari_config_watch_fini(&server->config_watch);
+#endif
+
+#ifdef HAVE_IPC
+  hikari_ipc_fini(&server->ipc);
+#endif
+
+#ifdef HAVE_TRACE
+  hikari_trace_fini();
+#endif
+
+#ifdef HAVE_RECORD
+  hikari_recorder_fini(&server->recorder);
+#endif
+
   hikari_cursor_fini(&server->cursor);
   hikari_indicator_fini(&server->indicator);
 
@@ -1028,6 +1082,10 @@ hikari_server_stop(void)
 
   wl_display_destroy_clients(server->display);
 
+#ifdef HAVE_IDLE
+  hikari_idle_fini(&server->idle);
+#endif
+
 #if HAVE_XWAYLAND
   wlr_xwayland_destroy(server->xwayland);
 #endif
@@ -1038,6 +1096,12 @@ hikari_server_stop(void)
 
   hikari_configuration_fini(hikari_configuration);
   hikari_free(hikari_configuration);
+  hikari_keymap_cache_fini();
+  hikari_placements_fini();
+  hikari_view_index_fini(&server->view_index);
+  hikari_view_table_fini(&server->view_table);
+  hikari_overview_mode_fini(&server->overview_mode);
+  hikari_group_trie_fini(&server->group_trie);
   hikari_marks_fini();
 
   free(server->config_path);
@@ -1046,14 +1110,10 @@ hikari_server_stop(void)
 struct hikari_group *
 hikari_server_find_group(const char *group_name)
 {
-  struct hikari_group *group;
-  wl_list_for_each (group, &hikari_server.groups, server_groups) {
-    if (!strcmp(group_name, group->name)) {
-      return group;
-    }
-  }
+  struct hikari_group_trie_node *node =
+      hikari_group_trie_lookup(&hikari_server.group_trie, group_name);
 
-  return NULL;
+  return node != NULL ? node->group : NULL;
 }
 
 struct hikari_group *
@@ -1079,6 +1139,10 @@ void
 hikari_server_reload(void *arg)
 {
   hikari_configuration_reload(hikari_server.config_path);
+
+#ifdef HAVE_INOTIFY
+  hikari_config_watch_update(&hikari_server.config_watch);
+#endif
 }
 
 #define CYCLE_VIEW(name, link)                                                 \
@@ -1280,6 +1344,12 @@ hikari_server_enter_mark_select_switch_mode(void *arg)
   hikari_mark_select_mode_enter(true);
 }
 
+void
+hikari_server_enter_find_mode(void *arg)
+{
+  hikari_find_mode_enter();
+}
+
 void
 hikari_server_enter_layout_select_mode(void *arg)
 {
@@ -1293,6 +1363,12 @@ hikari_server_enter_layout_select_mode(void *arg)
   hikari_layout_select_mode_enter();
 }
 
+void
+hikari_server_enter_overview_mode(void *arg)
+{
+  hikari_overview_mode_enter();
+}
+
 void
 hikari_server_enter_mark_assign_mode(void *arg)
 {
@@ -1439,6 +1515,25 @@ hikari_server_switch_to_mark(void *arg)
   show_marked_view(view, mark);
 }
 
+void
+hikari_server_switch_to_view(struct hikari_view *view)
+{
+  assert(view != NULL);
+
+  if (view->sheet->workspace->sheet != view->sheet) {
+    hikari_workspace_switch_sheet(view->sheet->workspace, view->sheet);
+  }
+
+  if (hikari_view_is_hidden(view)) {
+    hikari_view_show(view);
+  } else {
+    hikari_view_raise(view);
+  }
+
+  hikari_view_center_cursor(view);
+  hikari_server_cursor_focus();
+}
+
 void
 hikari_server_migrate_focus_view(
     struct hikari_output *output, double lx, double ly, bool center)
@@ -1639,7 +1734,6 @@ hikari_server_hide_group(void *arg)
   hikari_server_cursor_focus();
 }
 
-#ifndef NDEBUG
 void
 hikari_server_toggle_damage_tracking(void *arg)
 {
@@ -1650,4 +1744,3 @@ hikari_server_toggle_damage_tracking(void *arg)
     hikari_output_damage_whole(output);
   }
 }
-#endif
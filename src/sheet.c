@@ -2,12 +2,16 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <hikari/configuration.h>
 #include <hikari/group.h>
 #include <hikari/layout.h>
+#include <hikari/layout_generator.h>
 #include <hikari/memory.h>
 #include <hikari/split.h>
+#include <hikari/tile.h>
+#include <hikari/trace.h>
 #include <hikari/view.h>
 
 void
@@ -279,6 +283,42 @@ LAYOUT(single)
 LAYOUT(empty)
 #undef LAYOUT
 
+struct hikari_view *
+hikari_sheet_generated_layout(struct hikari_sheet *sheet,
+    struct hikari_layout_generator *generator,
+    struct hikari_view *first,
+    struct wlr_box *frame,
+    int max,
+    bool *center)
+{
+  int nr_of_views = tileable_views(first);
+  if (nr_of_views > max) {
+    nr_of_views = max;
+  }
+  if (nr_of_views == 0) {
+    return max != 0 ? NULL : first;
+  }
+
+  struct wlr_box *boxes = hikari_calloc(nr_of_views, sizeof(struct wlr_box));
+
+  if (!hikari_layout_generator_request(
+          generator, nr_of_views, frame, boxes)) {
+    hikari_free(boxes);
+    return grid_layout(frame, first, nr_of_views, center);
+  }
+
+  struct hikari_view *view = first;
+  for (int i = 0; i < nr_of_views && view != NULL; i++) {
+    hikari_view_tile(view, &boxes[i], *center);
+    *center = false;
+    view = scan_next_tileable_view(view);
+  }
+
+  hikari_free(boxes);
+
+  return view;
+}
+
 #undef LAYOUT_WINDOWS
 
 #define SHEET_VIEW(name, link)                                                 \
@@ -396,9 +436,75 @@ raise_floating(struct hikari_sheet *sheet)
   }
 }
 
+#ifndef NDEBUG
+static void
+border_box(struct hikari_tile *tile, int extent, struct wlr_box *box)
+{
+  box->x = tile->tile_geometry.x - extent;
+  box->y = tile->tile_geometry.y - extent;
+  box->width = tile->tile_geometry.width + extent * 2;
+  box->height = tile->tile_geometry.height + extent * 2;
+}
+
+static void
+check_layout(struct hikari_layout *layout, struct wlr_box *frame)
+{
+  int border = hikari_configuration->border;
+  int gap = hikari_configuration->gap;
+  struct wlr_box outer, spaced, other_outer, intersection;
+
+  struct hikari_tile *tile, *other;
+  wl_list_for_each (tile, &layout->tiles, layout_tiles) {
+    border_box(tile, border, &outer);
+
+    if (!wlr_box_intersection(&intersection, &outer, frame) ||
+        memcmp(&intersection, &outer, sizeof(struct wlr_box))) {
+      fprintf(stderr,
+          "layout warning: tile %d %d %d %d exceeds usable area\n",
+          outer.x,
+          outer.y,
+          outer.width,
+          outer.height);
+    }
+
+    border_box(tile, border + gap, &spaced);
+
+    wl_list_for_each (other, &layout->tiles, layout_tiles) {
+      if (other == tile) {
+        break;
+      }
+
+      if (!memcmp(&other->tile_geometry,
+              &tile->tile_geometry,
+              sizeof(struct wlr_box))) {
+        continue;
+      }
+
+      border_box(other, border, &other_outer);
+
+      if (wlr_box_intersection(&intersection, &spaced, &other_outer)) {
+        fprintf(stderr,
+            "layout warning: tiles %d %d %d %d and %d %d %d %d are closer "
+            "than the gap\n",
+            outer.x,
+            outer.y,
+            outer.width,
+            outer.height,
+            other_outer.x,
+            other_outer.y,
+            other_outer.width,
+            other_outer.height);
+      }
+    }
+  }
+}
+#endif
+
 void
 hikari_sheet_apply_split(struct hikari_sheet *sheet, struct hikari_split *split)
 {
+  HIKARI_TRACE_SCOPE("apply_split");
+
   struct hikari_layout *layout;
   if (sheet->layout != NULL) {
     layout = sheet->layout;
@@ -427,9 +533,24 @@ hikari_sheet_apply_split(struct hikari_sheet *sheet, struct hikari_split *split)
 
   hikari_split_apply(layout->split, &geometry, first);
 
+#ifndef NDEBUG
+  check_layout(layout, &output->usable_area);
+#endif
+
   raise_floating(sheet);
 }
 
+void
+hikari_sheet_retile(struct hikari_sheet *sheet, struct hikari_split *split)
+{
+  hikari_sheet_apply_split(sheet, split);
+
+  struct hikari_view *view, *view_temp;
+  wl_list_for_each_safe (view, view_temp, &sheet->views, sheet_views) {
+    hikari_view_settle(view);
+  }
+}
+
 bool
 hikari_sheet_is_visible(struct hikari_sheet *sheet)
 {
@@ -0,0 +1,293 @@
+#include <hikari/slab.h>
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <hikari/animation.h>
+#include <hikari/group_trie.h>
+#include <hikari/maximized_state.h>
+#include <hikari/memory.h>
+#include <hikari/tile.h>
+#include <hikari/view.h>
+#include <hikari/xdg_view.h>
+
+#ifdef HAVE_XWAYLAND
+#include <hikari/xwayland_unmanaged_view.h>
+#include <hikari/xwayland_view.h>
+#endif
+
+#ifdef HAVE_LAYERSHELL
+#include <hikari/layer_shell.h>
+#endif
+
+struct hikari_slab_chunk {
+  struct wl_list link;
+  struct hikari_slab *slab;
+  void *free_list;
+  size_t used;
+  max_align_t data[];
+};
+
+struct hikari_slab hikari_animation_slab =
+    HIKARI_SLAB("animation", sizeof(struct hikari_animation));
+struct hikari_slab hikari_xdg_view_slab =
+    HIKARI_SLAB("xdg_view", sizeof(struct hikari_xdg_view));
+struct hikari_slab hikari_xdg_popup_slab =
+    HIKARI_SLAB("xdg_popup", sizeof(struct hikari_xdg_popup));
+struct hikari_slab hikari_view_subsurface_slab =
+    HIKARI_SLAB("view_subsurface", sizeof(struct hikari_view_subsurface));
+struct hikari_slab hikari_tile_slab =
+    HIKARI_SLAB("tile", sizeof(struct hikari_tile));
+struct hikari_slab hikari_maximized_state_slab =
+    HIKARI_SLAB("maximized_state", sizeof(struct hikari_maximized_state));
+struct hikari_slab hikari_group_trie_node_slab =
+    HIKARI_SLAB("group_trie_node", sizeof(struct hikari_group_trie_node));
+
+#ifdef HAVE_XWAYLAND
+struct hikari_slab hikari_xwayland_view_slab =
+    HIKARI_SLAB("xwayland_view", sizeof(struct hikari_xwayland_view));
+struct hikari_slab hikari_xwayland_unmanaged_view_slab =
+    HIKARI_SLAB("xwayland_unmanaged_view",
+        sizeof(struct hikari_xwayland_unmanaged_view));
+#endif
+
+#ifdef HAVE_LAYERSHELL
+struct hikari_slab hikari_layer_popup_slab =
+    HIKARI_SLAB("layer_popup", sizeof(struct hikari_layer_popup));
+#endif
+
+static struct hikari_slab string_slabs[] = {
+  HIKARI_SLAB("string16", 16),
+  HIKARI_SLAB("string32", 32),
+  HIKARI_SLAB("string64", 64),
+  HIKARI_SLAB("string128", 128),
+  HIKARI_SLAB("string256", 256),
+};
+
+static const int nr_of_string_slabs =
+    sizeof(string_slabs) / sizeof(string_slabs[0]);
+
+static struct hikari_slab *slabs = NULL;
+
+static size_t
+slot_size(struct hikari_slab *slab)
+{
+  size_t align = sizeof(max_align_t);
+
+  return (slab->size + align - 1) / align * align;
+}
+
+static size_t
+slots_per_chunk(struct hikari_slab *slab)
+{
+  size_t header = offsetof(struct hikari_slab_chunk, data);
+
+  return (HIKARI_SLAB_CHUNK_SIZE - header) / slot_size(slab);
+}
+
+static void
+init_slab(struct hikari_slab *slab)
+{
+  assert(slots_per_chunk(slab) > 0);
+
+  wl_list_init(&slab->partial_chunks);
+  wl_list_init(&slab->full_chunks);
+  slab->spare = NULL;
+  slab->nr_of_chunks = 0;
+  slab->nr_of_objects = 0;
+  slab->peak = 0;
+  slab->initialized = true;
+
+  slab->next = slabs;
+  slabs = slab;
+}
+
+static struct hikari_slab_chunk *
+create_chunk(struct hikari_slab *slab)
+{
+  struct hikari_slab_chunk *chunk;
+
+  if (posix_memalign(
+          (void **)&chunk, HIKARI_SLAB_CHUNK_SIZE, HIKARI_SLAB_CHUNK_SIZE) != 0) {
+    fprintf(stderr,
+        "slab error: could not allocate chunk for \"%s\"\n",
+        slab->name);
+    abort();
+  }
+
+  size_t size = slot_size(slab);
+  size_t nr_of_slots = slots_per_chunk(slab);
+  char *slot = (char *)chunk->data;
+
+  chunk->slab = slab;
+  chunk->used = 0;
+  chunk->free_list = NULL;
+
+  for (size_t i = 0; i < nr_of_slots; i++) {
+    *(void **)slot = chunk->free_list;
+    chunk->free_list = slot;
+    slot += size;
+  }
+
+  slab->nr_of_chunks++;
+
+  return chunk;
+}
+
+static struct hikari_slab_chunk *
+chunk_of(void *ptr)
+{
+  return (struct hikari_slab_chunk *)((uintptr_t)ptr &
+                                      ~(uintptr_t)(HIKARI_SLAB_CHUNK_SIZE - 1));
+}
+
+void *
+hikari_slab_alloc(struct hikari_slab *slab)
+{
+  if (!slab->initialized) {
+    init_slab(slab);
+  }
+
+  struct hikari_slab_chunk *chunk;
+
+  if (!wl_list_empty(&slab->partial_chunks)) {
+    chunk = wl_container_of(slab->partial_chunks.next, chunk, link);
+  } else {
+    if (slab->spare != NULL) {
+      chunk = slab->spare;
+      slab->spare = NULL;
+    } else {
+      chunk = create_chunk(slab);
+    }
+
+    wl_list_insert(&slab->partial_chunks, &chunk->link);
+  }
+
+  void *ptr = chunk->free_list;
+  chunk->free_list = *(void **)ptr;
+  chunk->used++;
+
+  if (chunk->free_list == NULL) {
+    wl_list_remove(&chunk->link);
+    wl_list_insert(&slab->full_chunks, &chunk->link);
+  }
+
+  if (++slab->nr_of_objects > slab->peak) {
+    slab->peak = slab->nr_of_objects;
+  }
+
+  return ptr;
+}
+
+void
+hikari_slab_free(struct hikari_slab *slab, void *ptr)
+{
+  if (ptr == NULL) {
+    return;
+  }
+
+  struct hikari_slab_chunk *chunk = chunk_of(ptr);
+
+  // handing a chunk the wrong object corrupts both slabs' free lists
+  if (chunk->slab != slab) {
+    fprintf(stderr,
+        "slab error: object %p does not belong to \"%s\"\n",
+        ptr,
+        slab->name);
+    abort();
+  }
+
+  if (chunk->free_list == NULL) {
+    wl_list_remove(&chunk->link);
+    wl_list_insert(&slab->partial_chunks, &chunk->link);
+  }
+
+  *(void **)ptr = chunk->free_list;
+  chunk->free_list = ptr;
+  chunk->used--;
+  slab->nr_of_objects--;
+
+  if (chunk->used == 0) {
+    wl_list_remove(&chunk->link);
+
+    if (slab->spare == NULL) {
+      slab->spare = chunk;
+    } else {
+      free(chunk);
+      slab->nr_of_chunks--;
+    }
+  }
+}
+
+void
+hikari_slab_for_each(void (*func)(struct hikari_slab *, void *), void *data)
+{
+  for (struct hikari_slab *slab = slabs; slab != NULL; slab = slab->next) {
+    func(slab, data);
+  }
+}
+
+static struct hikari_slab *
+string_slab(size_t size)
+{
+  for (int i = 0; i < nr_of_string_slabs; i++) {
+    if (size <= string_slabs[i].size) {
+      return &string_slabs[i];
+    }
+  }
+
+  return NULL;
+}
+
+// strings are prefixed with a byte telling whether they live in a slab, the
+// slab itself is found through the header of the chunk they were taken from
+enum hikari_string_origin { HIKARI_STRING_HEAP, HIKARI_STRING_SLAB };
+
+char *
+hikari_string_dup(const char *str)
+{
+  size_t size = strlen(str) + 1;
+  struct hikari_slab *slab = string_slab(size + 1);
+  unsigned char *ret;
+
+  if (slab != NULL) {
+    ret = hikari_slab_alloc(slab);
+    ret[0] = HIKARI_STRING_SLAB;
+  } else {
+    ret = hikari_malloc(size + 1);
+    if (ret == NULL) {
+      return NULL;
+    }
+    ret[0] = HIKARI_STRING_HEAP;
+  }
+
+  memcpy(ret + 1, str, size);
+
+  return (char *)ret + 1;
+}
+
+void
+hikari_string_free(char *str)
+{
+  if (str == NULL) {
+    return;
+  }
+
+  unsigned char *ptr = (unsigned char *)str - 1;
+
+  if (ptr[0] == HIKARI_STRING_SLAB) {
+    struct hikari_slab *slab = chunk_of(ptr)->slab;
+
+    if (slab < string_slabs || slab >= string_slabs + nr_of_string_slabs) {
+      fprintf(stderr, "slab error: %p is not a string\n", str);
+      abort();
+    }
+
+    hikari_slab_free(slab, ptr);
+  } else {
+    hikari_free(ptr);
+  }
+}
@@ -3,6 +3,8 @@
 #include <hikari/color.h>
 #include <hikari/configuration.h>
 #include <hikari/geometry.h>
+#include <hikari/layout_generator.h>
+#include <hikari/sheet.h>
 #include <hikari/view.h>
 
 const double hikari_split_scale_min = 0.1;
@@ -90,6 +92,10 @@ copy_split_container(struct hikari_split_container *split_container)
   hikari_split_container_init(
       ret, split_container->max, split_container->layout);
 
+  if (split_container->generator != NULL) {
+    ret->generator = hikari_layout_generator_ref(split_container->generator);
+  }
+
   return (struct hikari_split *)ret;
 }
 
@@ -124,6 +130,38 @@ hikari_split_copy(struct hikari_split *split)
   return copy_split(split);
 }
 
+bool
+hikari_split_uses_generator(
+    struct hikari_split *split, struct hikari_layout_generator *generator)
+{
+  switch (split->type) {
+    case HIKARI_SPLIT_TYPE_VERTICAL: {
+      struct hikari_split_vertical *split_vertical =
+          (struct hikari_split_vertical *)split;
+
+      return hikari_split_uses_generator(split_vertical->left, generator) ||
+             hikari_split_uses_generator(split_vertical->right, generator);
+    }
+
+    case HIKARI_SPLIT_TYPE_HORIZONTAL: {
+      struct hikari_split_horizontal *split_horizontal =
+          (struct hikari_split_horizontal *)split;
+
+      return hikari_split_uses_generator(split_horizontal->top, generator) ||
+             hikari_split_uses_generator(split_horizontal->bottom, generator);
+    }
+
+    case HIKARI_SPLIT_TYPE_CONTAINER: {
+      struct hikari_split_container *container =
+          (struct hikari_split_container *)split;
+
+      return container->generator == generator;
+    }
+  }
+
+  return false;
+}
+
 static struct hikari_view *
 apply_split(struct hikari_split *split,
     struct wlr_box *geometry,
@@ -187,8 +225,17 @@ apply_split(struct hikari_split *split,
       struct hikari_split_container *container =
           (struct hikari_split_container *)split;
       container->geometry = *geometry;
-      view = container->layout(
-          view->sheet, view, geometry, container->max, center);
+      if (container->generator != NULL) {
+        view = hikari_sheet_generated_layout(view->sheet,
+            container->generator,
+            view,
+            geometry,
+            container->max,
+            center);
+      } else {
+        view = container->layout(
+            view->sheet, view, geometry, container->max, center);
+      }
     } break;
   }
 
@@ -220,6 +267,7 @@ hikari_split_container_init(struct hikari_split_container *container,
   container->split.type = HIKARI_SPLIT_TYPE_CONTAINER;
   container->max = nr_of_views;
   container->layout = layout;
+  container->generator = NULL;
   container->geometry = (struct wlr_box){ 0 };
 }
 
@@ -288,6 +336,9 @@ hikari_split_free(struct hikari_split *split)
       struct hikari_split_container *container =
           (struct hikari_split_container *)split;
 
+      if (container->generator != NULL) {
+        hikari_layout_generator_unref(container->generator);
+      }
       hikari_free(container);
     } break;
   }
@@ -0,0 +1,169 @@
+#include <hikari/stacking.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include <wlr/types/wlr_surface.h>
+
+#include <hikari/memory.h>
+#include <hikari/view.h>
+
+static unsigned long generation = 1;
+
+void
+hikari_stacking_init(struct hikari_stacking *stacking)
+{
+  stacking->views = NULL;
+  stacking->bounds = NULL;
+  stacking->nested = NULL;
+  stacking->nr_of_views = 0;
+  stacking->capacity = 0;
+  stacking->generation = 0;
+}
+
+void
+hikari_stacking_fini(struct hikari_stacking *stacking)
+{
+  hikari_free(stacking->views);
+  hikari_free(stacking->bounds);
+  hikari_free(stacking->nested);
+}
+
+void
+hikari_stacking_invalidate(void)
+{
+  generation++;
+}
+
+static void
+reserve(struct hikari_stacking *stacking, int nr_of_views)
+{
+  if (nr_of_views <= stacking->capacity) {
+    return;
+  }
+
+  int capacity = stacking->capacity == 0 ? 16 : stacking->capacity;
+  while (capacity < nr_of_views) {
+    capacity *= 2;
+  }
+
+  hikari_stacking_fini(stacking);
+
+  stacking->views = hikari_malloc(capacity * sizeof(struct hikari_view *));
+  stacking->bounds = hikari_malloc(capacity * sizeof(struct wlr_box));
+  stacking->nested = hikari_malloc(capacity * sizeof(bool));
+  stacking->capacity = capacity;
+}
+
+static void
+bounds(struct hikari_view *view, struct wlr_box *box)
+{
+  struct wlr_box *geometry = hikari_view_border_geometry(view);
+  struct wlr_box *view_geometry = hikari_view_geometry(view);
+  struct wlr_surface *surface = view->surface;
+
+  int x2 = geometry->x + geometry->width;
+  int y2 = geometry->y + geometry->height;
+
+  if (surface != NULL) {
+    int surface_x2 = view_geometry->x + surface->current.width;
+    int surface_y2 = view_geometry->y + surface->current.height;
+
+    x2 = surface_x2 > x2 ? surface_x2 : x2;
+    y2 = surface_y2 > y2 ? surface_y2 : y2;
+  }
+
+  box->x = geometry->x;
+  box->y = geometry->y;
+  box->width = x2 - geometry->x;
+  box->height = y2 - geometry->y;
+}
+
+#ifndef NDEBUG
+static void
+check_snapshot(struct hikari_stacking *stacking, struct wl_list *views)
+{
+  struct wlr_box box;
+  int i = 0;
+
+  struct hikari_view *view;
+  wl_list_for_each (view, views, workspace_views) {
+    if (i == stacking->nr_of_views || stacking->views[i] != view) {
+      fprintf(stderr, "stacking warning: order changed without invalidation\n");
+      return;
+    }
+
+    bounds(view, &box);
+
+    if (memcmp(&box, &stacking->bounds[i], sizeof(struct wlr_box)) ||
+        stacking->nested[i] != !wl_list_empty(&view->children)) {
+      fprintf(stderr,
+          "stacking warning: view %p changed without invalidation\n",
+          view);
+    }
+
+    i++;
+  }
+
+  if (i != stacking->nr_of_views) {
+    fprintf(stderr, "stacking warning: order changed without invalidation\n");
+  }
+}
+#endif
+
+void
+hikari_stacking_update(struct hikari_stacking *stacking, struct wl_list *views)
+{
+  if (stacking->generation == generation) {
+#ifndef NDEBUG
+    check_snapshot(stacking, views);
+#endif
+    return;
+  }
+
+  reserve(stacking, wl_list_length(views));
+
+  int i = 0;
+  struct hikari_view *view;
+  wl_list_for_each (view, views, workspace_views) {
+    stacking->views[i] = view;
+    stacking->nested[i] = !wl_list_empty(&view->children);
+    bounds(view, &stacking->bounds[i]);
+    i++;
+  }
+
+  stacking->nr_of_views = i;
+  stacking->generation = generation;
+}
+
+bool
+hikari_stacking_may_contain(
+    struct hikari_stacking *stacking, int i, double ox, double oy)
+{
+  if (stacking->nested[i]) {
+    return true;
+  }
+
+  struct wlr_box *box = &stacking->bounds[i];
+
+  return ox >= box->x && oy >= box->y && ox < box->x + box->width &&
+         oy < box->y + box->height;
+}
+
+bool
+hikari_stacking_may_intersect(
+    struct hikari_stacking *stacking, int i, pixman_region32_t *region)
+{
+  if (stacking->nested[i]) {
+    return true;
+  }
+
+  struct wlr_box *box = &stacking->bounds[i];
+
+  pixman_box32_t rect = { .x1 = box->x,
+    .y1 = box->y,
+    .x2 = box->x + box->width,
+    .y2 = box->y + box->height };
+
+  return pixman_region32_contains_rectangle(region, &rect) != PIXMAN_REGION_OUT;
+}
@@ -0,0 +1,166 @@
+#include <hikari/surface_cache.h>
+
+#include <string.h>
+
+#include <wlr/types/wlr_surface.h>
+
+#include <hikari/memory.h>
+#include <hikari/node.h>
+
+void
+hikari_surface_cache_init(struct hikari_surface_cache *surface_cache)
+{
+  surface_cache->entries = NULL;
+  surface_cache->nr_of_entries = 0;
+  surface_cache->capacity = 0;
+  surface_cache->dirty = true;
+}
+
+void
+hikari_surface_cache_fini(struct hikari_surface_cache *surface_cache)
+{
+  hikari_free(surface_cache->entries);
+}
+
+static void
+reserve(struct hikari_surface_cache *surface_cache, int nr_of_entries)
+{
+  if (nr_of_entries <= surface_cache->capacity) {
+    return;
+  }
+
+  int capacity = surface_cache->capacity == 0 ? 4 : surface_cache->capacity;
+  while (capacity < nr_of_entries) {
+    capacity *= 2;
+  }
+
+  struct hikari_surface_cache_entry *entries =
+      hikari_malloc(capacity * sizeof(struct hikari_surface_cache_entry));
+
+  memcpy(entries,
+      surface_cache->entries,
+      surface_cache->nr_of_entries * sizeof(struct hikari_surface_cache_entry));
+
+  hikari_free(surface_cache->entries);
+  surface_cache->entries = entries;
+  surface_cache->capacity = capacity;
+}
+
+static void
+add_entry(struct wlr_surface *surface, int sx, int sy, void *data)
+{
+  struct hikari_surface_cache *surface_cache = data;
+
+  reserve(surface_cache, surface_cache->nr_of_entries + 1);
+
+  struct hikari_surface_cache_entry *entry =
+      &surface_cache->entries[surface_cache->nr_of_entries++];
+
+  entry->surface = surface;
+  entry->box.x = sx;
+  entry->box.y = sy;
+  entry->box.width = surface->current.width;
+  entry->box.height = surface->current.height;
+}
+
+static struct hikari_surface_cache_entry *
+find_entry(
+    struct hikari_surface_cache *surface_cache, struct wlr_surface *surface)
+{
+  for (int i = 0; i < surface_cache->nr_of_entries; i++) {
+    if (surface_cache->entries[i].surface == surface) {
+      return &surface_cache->entries[i];
+    }
+  }
+
+  return NULL;
+}
+
+static bool
+entry_matches(struct hikari_surface_cache_entry *entry,
+    struct wlr_surface *surface,
+    int sx,
+    int sy)
+{
+  return entry != NULL && entry->box.x == sx && entry->box.y == sy &&
+         entry->box.width == surface->current.width &&
+         entry->box.height == surface->current.height;
+}
+
+static bool
+subsurfaces_match(struct hikari_surface_cache *surface_cache,
+    struct wl_list *subsurfaces,
+    int sx,
+    int sy)
+{
+  struct wlr_subsurface *subsurface;
+  wl_list_for_each (subsurface, subsurfaces, current.link) {
+    struct hikari_surface_cache_entry *entry =
+        find_entry(surface_cache, subsurface->surface);
+
+    if (!subsurface->mapped) {
+      if (entry != NULL) {
+        return false;
+      }
+      continue;
+    }
+
+    if (!entry_matches(entry,
+            subsurface->surface,
+            sx + subsurface->current.x,
+            sy + subsurface->current.y)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void
+hikari_surface_cache_commit(struct hikari_surface_cache *surface_cache,
+    struct wlr_surface *surface,
+    int sx,
+    int sy)
+{
+  if (surface_cache->dirty) {
+    return;
+  }
+
+  // a commit applies the positions of synchronized subsurfaces as well
+  if (!entry_matches(find_entry(surface_cache, surface), surface, sx, sy) ||
+      !subsurfaces_match(
+          surface_cache, &surface->current.subsurfaces_below, sx, sy) ||
+      !subsurfaces_match(
+          surface_cache, &surface->current.subsurfaces_above, sx, sy)) {
+    surface_cache->dirty = true;
+  }
+}
+
+struct wlr_surface *
+hikari_surface_cache_surface_at(struct hikari_surface_cache *surface_cache,
+    struct hikari_node *node,
+    double x,
+    double y,
+    double *sx,
+    double *sy)
+{
+  if (surface_cache->dirty) {
+    surface_cache->nr_of_entries = 0;
+    hikari_node_for_each_surface(node, add_entry, surface_cache);
+    surface_cache->dirty = false;
+  }
+
+  for (int i = surface_cache->nr_of_entries - 1; i >= 0; i--) {
+    struct hikari_surface_cache_entry *entry = &surface_cache->entries[i];
+    double entry_sx = x - entry->box.x;
+    double entry_sy = y - entry->box.y;
+
+    if (wlr_surface_point_accepts_input(entry->surface, entry_sx, entry_sy)) {
+      *sx = entry_sx;
+      *sy = entry_sy;
+      return entry->surface;
+    }
+  }
+
+  return NULL;
+}
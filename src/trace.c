@@ -0,0 +1,141 @@
+#include <hikari/trace.h>
+
+#include <fcntl.h>
+#include <inttypes.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+static struct hikari_trace_event events[HIKARI_TRACE_RING_SIZE];
+static size_t next_event = 0;
+static bool wrapped = false;
+
+static struct wl_event_source *signal_source = NULL;
+static char path[256];
+
+static void
+record(const char *name, char phase)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  struct hikari_trace_event *event = &events[next_event];
+
+  event->name = name;
+  event->timestamp = (uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec;
+  event->phase = phase;
+
+  if (++next_event == HIKARI_TRACE_RING_SIZE) {
+    next_event = 0;
+    wrapped = true;
+  }
+}
+
+void
+hikari_trace_begin(const char *name)
+{
+  record(name, 'B');
+}
+
+void
+hikari_trace_end(const char *name)
+{
+  record(name, 'E');
+}
+
+const char *
+hikari_trace_dump(void)
+{
+  if (path[0] == '\0') {
+    fprintf(stderr, "could not write trace without XDG_RUNTIME_DIR\n");
+    return NULL;
+  }
+
+  int fd = open(
+      path, O_WRONLY | O_CREAT | O_TRUNC | O_NOFOLLOW | O_CLOEXEC, 0600);
+  FILE *file = fd != -1 ? fdopen(fd, "w") : NULL;
+
+  if (file == NULL) {
+    fprintf(stderr, "could not write trace to \"%s\"\n", path);
+    if (fd != -1) {
+      close(fd);
+    }
+    return NULL;
+  }
+
+  size_t first = wrapped ? next_event : 0;
+  size_t nr_of_events = wrapped ? HIKARI_TRACE_RING_SIZE : next_event;
+  int depth = 0;
+  bool separator = false;
+
+  fprintf(file, "{\"traceEvents\":[");
+
+  for (size_t i = 0; i < nr_of_events; i++) {
+    struct hikari_trace_event *event =
+        &events[(first + i) % HIKARI_TRACE_RING_SIZE];
+
+    if (event->phase == 'E') {
+      if (depth == 0) {
+        continue;
+      }
+      depth--;
+    } else {
+      depth++;
+    }
+
+    fprintf(file,
+        "%s\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%" PRIu64
+        ".%03u,\"pid\":%d,\"tid\":1}",
+        separator ? "," : "",
+        event->name,
+        event->phase,
+        event->timestamp / 1000,
+        (unsigned)(event->timestamp % 1000),
+        (int)getpid());
+
+    separator = true;
+  }
+
+  fprintf(file, "\n]}\n");
+  fclose(file);
+
+  return path;
+}
+
+static int
+signal_handler(int signal_number, void *data)
+{
+  hikari_trace_dump();
+
+  return 0;
+}
+
+void
+hikari_trace_init(struct wl_event_loop *event_loop)
+{
+  const char *runtime_dir = getenv("XDG_RUNTIME_DIR");
+
+  // a shared directory such as /tmp would let other users plant the file
+  if (runtime_dir != NULL) {
+    snprintf(path,
+        sizeof(path),
+        "%s/hikari-trace-%d.json",
+        runtime_dir,
+        (int)getpid());
+  }
+
+  signal_source = wl_event_loop_add_signal(
+      event_loop, SIGUSR1, signal_handler, NULL);
+}
+
+void
+hikari_trace_fini(void)
+{
+  if (signal_source != NULL) {
+    wl_event_source_remove(signal_source);
+    signal_source = NULL;
+  }
+}
@@ -5,6 +5,7 @@
 
 #include <wlr/types/wlr_cursor.h>
 
+#include <hikari/animation.h>
 #include <hikari/color.h>
 #include <hikari/configuration.h>
 #include <hikari/geometry.h>
@@ -15,10 +16,13 @@
 #include <hikari/memory.h>
 #include <hikari/operation.h>
 #include <hikari/output.h>
+#include <hikari/placement.h>
 #include <hikari/server.h>
 #include <hikari/sheet.h>
+#include <hikari/slab.h>
 #include <hikari/tile.h>
 #include <hikari/view_config.h>
+#include <hikari/view_index.h>
 #include <hikari/workspace.h>
 #include <hikari/xdg_view.h>
 #include <hikari/xwayland_view.h>
@@ -81,6 +85,8 @@ place_visibly_above(
 
   wl_list_remove(&view->workspace_views);
   wl_list_insert(&workspace->views, &view->workspace_views);
+
+  hikari_stacking_invalidate();
 }
 
 static void
@@ -98,6 +104,8 @@ refresh_border_geometry(struct hikari_view *view)
   assert(view != NULL);
   hikari_border_refresh_geometry(&view->border, view->current_geometry);
   hikari_indicator_frame_refresh_geometry(&view->indicator_frame, view);
+
+  hikari_stacking_invalidate();
 }
 
 static inline void
@@ -116,6 +124,8 @@ move_view_constrained(
 static void
 move_view(struct hikari_view *view, struct wlr_box *geometry, int x, int y)
 {
+  struct wlr_box from = *hikari_view_geometry(view);
+
   if (view->maximized_state != NULL) {
     struct wlr_box *usable_area;
 
@@ -160,6 +170,7 @@ move_view(struct hikari_view *view, struct wlr_box *geometry, int x, int y)
   if (!hikari_view_is_hidden(view)) {
     hikari_view_damage_whole(view);
     hikari_indicator_damage(&hikari_server.indicator, view);
+    hikari_animation_start(view, &from);
   }
 }
 
@@ -194,10 +205,12 @@ decrease_group_visibility(struct hikari_view *view)
 static void
 hide(struct hikari_view *view)
 {
+  hikari_animation_cancel(view);
   decrease_group_visibility(view);
 
   wl_list_remove(&view->workspace_views);
   wl_list_init(&view->workspace_views);
+  hikari_stacking_invalidate();
 
   wl_list_remove(&view->visible_server_views);
   wl_list_init(&view->visible_server_views);
@@ -238,7 +251,7 @@ cancel_tile(struct hikari_view *view)
     struct hikari_tile *tile = view->pending_operation.tile;
 
     hikari_tile_detach(tile);
-    hikari_free(tile);
+    hikari_slab_free(&hikari_tile_slab, tile);
     view->pending_operation.tile = NULL;
   }
 }
@@ -253,6 +266,13 @@ guarded_resize(struct hikari_view *view,
   if (op->serial == 0) {
     f(view, op);
   } else {
+#ifdef HAVE_RECORD
+    hikari_recorder_mark(&hikari_server.recorder,
+        HIKARI_RECORDER_EVENT_CONFIGURE,
+        op->serial,
+        op->geometry.width,
+        op->geometry.height);
+#endif
     hikari_view_set_dirty(view);
   }
 }
@@ -284,10 +304,13 @@ static void
 commit_pending_geometry(
     struct hikari_view *view, struct wlr_box *pending_geometry)
 {
+  struct wlr_box from = *hikari_view_geometry(view);
+
   hikari_view_refresh_geometry(view, pending_geometry);
 
   hikari_indicator_damage(&hikari_server.indicator, view);
   hikari_view_damage_whole(view);
+  hikari_animation_start(view, &from);
 }
 
 static void
@@ -338,7 +361,7 @@ commit_reset(struct hikari_view *view, struct hikari_operation *operation)
 
   if (hikari_view_is_tiled(view)) {
     assert(!hikari_tile_is_attached(view->tile));
-    hikari_free(view->tile);
+    hikari_slab_free(&hikari_tile_slab, view->tile);
     view->tile = NULL;
   }
 
@@ -423,6 +446,9 @@ hikari_view_init(
   view->group = NULL;
   view->title = NULL;
   view->tile = NULL;
+  view->placement = NULL;
+  view->index_entry = NULL;
+  view->animation = NULL;
   view->id = NULL;
   view->use_csd = false;
   view->child = child;
@@ -432,7 +458,11 @@ hikari_view_init(
   hikari_view_unset_dirty(view);
   view->pending_operation.tile = NULL;
 
+  hikari_surface_cache_init(&view->surface_cache);
+
   wl_list_init(&view->children);
+
+  view->serial = hikari_view_table_insert(&hikari_server.view_table, view);
 }
 
 void
@@ -446,8 +476,10 @@ hikari_view_fini(struct hikari_view *view)
   printf("DESTROY VIEW %p\n", view);
 #endif
 
-  hikari_free(view->title);
-  hikari_free(view->id);
+  hikari_string_free(view->title);
+  hikari_string_free(view->id);
+  hikari_surface_cache_fini(&view->surface_cache);
+  hikari_view_table_remove(&hikari_server.view_table, view->serial);
 
   if (view->group != NULL) {
     detach_from_group(view);
@@ -469,7 +501,7 @@ hikari_view_fini(struct hikari_view *view)
   if (hikari_view_is_tiled(view)) {
     struct hikari_tile *tile = view->tile;
     hikari_tile_detach(tile);
-    hikari_free(tile);
+    hikari_slab_free(&hikari_tile_slab, tile);
     view->tile = NULL;
   }
 
@@ -479,11 +511,10 @@ hikari_view_fini(struct hikari_view *view)
 void
 hikari_view_set_title(struct hikari_view *view, const char *title)
 {
-  hikari_free(view->title);
+  hikari_string_free(view->title);
 
   if (title != NULL) {
-    view->title = hikari_malloc(strlen(title) + 1);
-    strcpy(view->title, title);
+    view->title = hikari_string_dup(title);
 
     if (hikari_server.workspace->focus_view == view) {
       assert(!hikari_view_is_hidden(view));
@@ -493,6 +524,10 @@ hikari_view_set_title(struct hikari_view *view, const char *title)
   } else {
     view->title = NULL;
   }
+
+  if (view->index_entry != NULL) {
+    hikari_view_index_update(&hikari_server.view_index, view);
+  }
 }
 
 static void
@@ -501,9 +536,7 @@ set_app_id(struct hikari_view *view, const char *id)
   assert(view->id == NULL);
   assert(id != NULL);
 
-  view->id = hikari_malloc(strlen(id) + 1);
-
-  strcpy(view->id, id);
+  view->id = hikari_string_dup(id);
 }
 
 struct hikari_damage_data {
@@ -783,7 +816,7 @@ new_subsurface_handler(struct wl_listener *listener, void *data)
   struct wlr_subsurface *wlr_subsurface = data;
 
   struct hikari_view_subsurface *view_subsurface =
-      hikari_malloc(sizeof(struct hikari_view_subsurface));
+      hikari_slab_alloc(&hikari_view_subsurface_slab);
 
   hikari_view_subsurface_init(view_subsurface, view, wlr_subsurface);
 }
@@ -804,6 +837,7 @@ hikari_view_map(struct hikari_view *view, struct wlr_surface *surface)
       hikari_configuration_resolve_view_config(hikari_configuration, view->id);
 
   view->surface = surface;
+  hikari_surface_cache_invalidate(&view->surface_cache);
 
   view->new_subsurface.notify = new_subsurface_handler;
   wl_signal_add(&surface->events.new_subsurface, &view->new_subsurface);
@@ -812,15 +846,13 @@ hikari_view_map(struct hikari_view *view, struct wlr_surface *surface)
   wl_list_for_each (
       wlr_subsurface, &surface->current.subsurfaces_below, current.link) {
     struct hikari_view_subsurface *subsurface =
-        (struct hikari_view_subsurface *)malloc(
-            sizeof(struct hikari_view_subsurface));
+        hikari_slab_alloc(&hikari_view_subsurface_slab);
     hikari_view_subsurface_init(subsurface, view, wlr_subsurface);
   }
   wl_list_for_each (
       wlr_subsurface, &surface->current.subsurfaces_above, current.link) {
     struct hikari_view_subsurface *subsurface =
-        (struct hikari_view_subsurface *)malloc(
-            sizeof(struct hikari_view_subsurface));
+        hikari_slab_alloc(&hikari_view_subsurface_slab);
     hikari_view_subsurface_init(subsurface, view, wlr_subsurface);
   }
 
@@ -850,6 +882,12 @@ hikari_view_map(struct hikari_view *view, struct wlr_surface *surface)
   wl_list_insert(&group->views, &view->group_views);
   wl_list_insert(&output->views, &view->output_views);
 
+  hikari_view_index_update(&hikari_server.view_index, view);
+
+  if (hikari_server_in_overview_mode()) {
+    hikari_overview_mode_refresh(&hikari_server.overview_mode);
+  }
+
   if (!hikari_server_in_lock_mode() || hikari_view_is_public(view)) {
     hikari_view_show(view);
 
@@ -863,6 +901,18 @@ hikari_view_map(struct hikari_view *view, struct wlr_surface *surface)
     increase_group_visiblity(view);
     raise_view(view);
   }
+
+#ifdef HAVE_IPC
+  hikari_ipc_notify_map(&hikari_server.ipc, view);
+#endif
+
+#ifdef HAVE_RECORD
+  hikari_recorder_mark(&hikari_server.recorder,
+      HIKARI_RECORDER_EVENT_MAP,
+      0,
+      view->geometry.width,
+      view->geometry.height);
+#endif
 }
 
 void
@@ -878,7 +928,7 @@ hikari_view_unmap(struct hikari_view *view)
     struct hikari_view_subsurface *subsurface =
         (struct hikari_view_subsurface *)child;
     hikari_view_subsurface_fini(subsurface);
-    hikari_free(subsurface);
+    hikari_slab_free(&hikari_view_subsurface_slab, subsurface);
   }
 
   if (hikari_view_is_forced(view)) {
@@ -901,15 +951,21 @@ hikari_view_unmap(struct hikari_view *view)
   assert(!hikari_view_is_forced(view));
 
   view->surface = NULL;
+  hikari_surface_cache_invalidate(&view->surface_cache);
 
   struct hikari_mark *mark = view->mark;
   if (mark != NULL) {
     hikari_mark_clear(mark);
   }
 
+  hikari_view_index_remove(&hikari_server.view_index, view);
+  hikari_animation_cancel(view);
+
   detach_from_group(view);
   view->group = NULL;
 
+  hikari_placement_forget(view);
+
   cancel_tile(view);
 
   if (hikari_view_is_tiled(view)) {
@@ -922,7 +978,7 @@ hikari_view_unmap(struct hikari_view *view)
       hikari_tile_detach(tile);
     }
 
-    hikari_free(tile);
+    hikari_slab_free(&hikari_tile_slab, tile);
     view->tile = NULL;
 
     hikari_view_refresh_geometry(view, &geometry);
@@ -934,12 +990,30 @@ hikari_view_unmap(struct hikari_view *view)
   wl_list_remove(&view->output_views);
   wl_list_init(&view->output_views);
 
+  // thumbnails are collected from the sheets, refresh only once the view has
+  // left its sheet
+  if (hikari_server_in_overview_mode()) {
+    hikari_overview_mode_refresh(&hikari_server.overview_mode);
+  }
+
   hikari_view_unset_dirty(view);
 
   assert(!hikari_view_is_tiling(view));
   assert(!hikari_view_is_tiled(view));
 }
 
+static inline void
+zoom_in(struct hikari_view *view)
+{
+  struct wlr_box *geometry = hikari_view_geometry(view);
+  struct wlr_box from = { .x = geometry->x + geometry->width / 20,
+    .y = geometry->y + geometry->height / 20,
+    .width = geometry->width - geometry->width / 10,
+    .height = geometry->height - geometry->height / 10 };
+
+  hikari_animation_start(view, &from);
+}
+
 void
 hikari_view_show(struct hikari_view *view)
 {
@@ -957,6 +1031,7 @@ hikari_view_show(struct hikari_view *view)
   raise_view(view);
 
   hikari_view_damage_whole(view);
+  zoom_in(view);
 
   assert(is_first_view(view));
 }
@@ -1020,6 +1095,7 @@ hikari_view_lower(struct hikari_view *view)
 
   wl_list_remove(&view->workspace_views);
   wl_list_insert(view->sheet->workspace->views.prev, &view->workspace_views);
+  hikari_stacking_invalidate();
 
   wl_list_remove(&view->visible_server_views);
   wl_list_insert(hikari_server.visible_views.prev, &view->visible_server_views);
@@ -1043,10 +1119,10 @@ commit_tile(struct hikari_view *view, struct hikari_operation *operation)
   if (hikari_view_is_tiled(view)) {
     struct hikari_tile *tile = view->tile;
 
-    assert(hikari_tile_is_attached(tile));
-
-    wl_list_remove(&tile->layout_tiles);
-    hikari_free(tile);
+    if (hikari_tile_is_attached(tile)) {
+      wl_list_remove(&tile->layout_tiles);
+    }
+    hikari_slab_free(&hikari_tile_slab, tile);
     view->tile = NULL;
   }
 
@@ -1102,7 +1178,7 @@ hikari_view_tile(
 
   struct hikari_layout *layout = view->sheet->workspace->sheet->layout;
 
-  struct hikari_tile *tile = hikari_malloc(sizeof(struct hikari_tile));
+  struct hikari_tile *tile = hikari_slab_alloc(&hikari_tile_slab);
   hikari_tile_init(tile, view, layout, geometry, geometry);
 
   queue_tile(view, layout, tile, center);
@@ -1115,8 +1191,7 @@ commit_full_maximize(
     struct hikari_view *view, struct hikari_operation *operation)
 {
   if (!view->maximized_state) {
-    view->maximized_state =
-        hikari_malloc(sizeof(struct hikari_maximized_state));
+    view->maximized_state = hikari_maximized_state_alloc();
   }
 
   view->maximized_state->maximization = HIKARI_MAXIMIZATION_FULLY_MAXIMIZED;
@@ -1150,7 +1225,7 @@ commit_unmaximize(struct hikari_view *view, struct hikari_operation *operation)
 {
   hikari_view_damage_whole(view);
 
-  hikari_free(view->maximized_state);
+  hikari_maximized_state_destroy(view->maximized_state);
   view->maximized_state = NULL;
 
   if (!view->use_csd) {
@@ -1212,8 +1287,7 @@ commit_horizontal_maximize(
     struct hikari_view *view, struct hikari_operation *operation)
 {
   if (!view->maximized_state) {
-    view->maximized_state =
-        hikari_malloc(sizeof(struct hikari_maximized_state));
+    view->maximized_state = hikari_maximized_state_alloc();
   } else {
     switch (view->maximized_state->maximization) {
       case HIKARI_MAXIMIZATION_HORIZONTALLY_MAXIMIZED:
@@ -1265,8 +1339,7 @@ commit_vertical_maximize(
     struct hikari_view *view, struct hikari_operation *operation)
 {
   if (!view->maximized_state) {
-    view->maximized_state =
-        hikari_malloc(sizeof(struct hikari_maximized_state));
+    view->maximized_state = hikari_maximized_state_alloc();
   } else {
     switch (view->maximized_state->maximization) {
       case HIKARI_MAXIMIZATION_HORIZONTALLY_MAXIMIZED:
@@ -1387,7 +1460,8 @@ hikari_view_reset_geometry(struct hikari_view *view)
 }
 
 void
-hikari_view_evacuate(struct hikari_view *view, struct hikari_sheet *sheet)
+hikari_view_evacuate(
+    struct hikari_view *view, struct hikari_sheet *sheet, bool retile)
 {
 #ifndef NDEBUG
   printf("EVACUATE VIEW %p\n", view);
@@ -1395,6 +1469,9 @@ hikari_view_evacuate(struct hikari_view *view, struct hikari_sheet *sheet)
 
   clear_focus(view);
 
+  // a running animation damages and is stepped by the output it started on
+  hikari_animation_cancel(view);
+
   view->output = sheet->workspace->output;
   view->sheet = sheet;
 
@@ -1405,10 +1482,7 @@ hikari_view_evacuate(struct hikari_view *view, struct hikari_sheet *sheet)
       raise_view(view);
     }
 
-    if (hikari_sheet_is_visible(sheet)) {
-      hikari_view_damage_whole(view);
-      hikari_indicator_damage(&hikari_server.indicator, view);
-    } else {
+    if (!hikari_sheet_is_visible(sheet)) {
       if (hikari_view_is_forced(view)) {
         move_to_top(view);
       } else {
@@ -1423,11 +1497,49 @@ hikari_view_evacuate(struct hikari_view *view, struct hikari_sheet *sheet)
     }
   }
 
-  if (hikari_view_is_tiled(view) || hikari_view_is_maximized(view)) {
+  // views that get retiled by the caller only leave their layout here to
+  // spare them a configure to their floating geometry.
+  if (retile && hikari_view_is_tiled(view) && !hikari_view_is_dirty(view)) {
+    hikari_tile_detach(view->tile);
+  } else if (hikari_view_is_tiled(view) || hikari_view_is_maximized(view)) {
     queue_reset(view, false);
   }
 }
 
+void
+hikari_view_settle(struct hikari_view *view)
+{
+  if (hikari_view_is_tiled(view) && !hikari_tile_is_attached(view->tile) &&
+      !hikari_view_is_dirty(view)) {
+    queue_reset(view, false);
+  }
+}
+
+void
+hikari_view_restore_geometry(
+    struct hikari_view *view, struct wlr_box *geometry)
+{
+  struct wlr_box *view_geometry = hikari_view_geometry(view);
+
+  if (hikari_view_is_dirty(view) || hikari_view_is_tiled(view) ||
+      hikari_view_is_maximized(view) ||
+      !memcmp(view_geometry, geometry, sizeof(struct wlr_box))) {
+    return;
+  }
+
+  if (view_geometry->width == geometry->width &&
+      view_geometry->height == geometry->height) {
+    move_view(view, view_geometry, geometry->x, geometry->y);
+  } else {
+    queue_resize(view,
+        view_geometry,
+        geometry->x,
+        geometry->y,
+        geometry->width,
+        geometry->height);
+  }
+}
+
 void
 hikari_view_pin_to_sheet(struct hikari_view *view, struct hikari_sheet *sheet)
 {
@@ -1435,6 +1547,8 @@ hikari_view_pin_to_sheet(struct hikari_view *view, struct hikari_sheet *sheet)
   assert(sheet != NULL);
   assert(sheet->workspace->output == view->output);
 
+  hikari_placement_forget(view);
+
   if (view->sheet == sheet) {
     assert(!hikari_view_is_hidden(view));
 
@@ -1538,6 +1652,8 @@ hikari_view_group(struct hikari_view *view, struct hikari_group *group)
   remove_from_group(view);
   view->group = group;
 
+  hikari_view_index_update(&hikari_server.view_index, view);
+
   increase_group_visiblity(view);
 
   raise_view(view);
@@ -1564,8 +1680,8 @@ hikari_view_exchange(struct hikari_view *from, struct hikari_view *to)
   struct wlr_box *from_geometry = &from->tile->tile_geometry;
   struct wlr_box *to_geometry = &to->tile->tile_geometry;
 
-  struct hikari_tile *from_tile = hikari_malloc(sizeof(struct hikari_tile));
-  struct hikari_tile *to_tile = hikari_malloc(sizeof(struct hikari_tile));
+  struct hikari_tile *from_tile = hikari_slab_alloc(&hikari_tile_slab);
+  struct hikari_tile *to_tile = hikari_slab_alloc(&hikari_tile_slab);
 
   hikari_tile_init(from_tile, from, layout, to_geometry, to_geometry);
   hikari_tile_init(to_tile, to, layout, from_geometry, from_geometry);
@@ -1585,7 +1701,7 @@ destroy_subsurface_handler(struct wl_listener *listener, void *data)
 
   hikari_view_subsurface_fini(view_subsurface);
 
-  hikari_free(view_subsurface);
+  hikari_slab_free(&hikari_view_subsurface_slab, view_subsurface);
 }
 
 void
@@ -1609,6 +1725,9 @@ hikari_view_child_fini(struct hikari_view_child *view_child)
   wl_list_remove(&view_child->link);
   wl_list_remove(&view_child->commit.link);
   wl_list_remove(&view_child->new_subsurface.link);
+
+  hikari_surface_cache_invalidate(&view_child->parent->surface_cache);
+  hikari_stacking_invalidate();
 }
 
 void
@@ -1644,6 +1763,32 @@ damage_single_surface(struct wlr_surface *surface, int sx, int sy, void *data)
   }
 }
 
+static bool
+child_offset(struct hikari_view_child *view_child, int *sx, int *sy)
+{
+  struct wlr_surface *surface = view_child->surface;
+  int x = 0;
+  int y = 0;
+
+  while (surface != NULL && wlr_surface_is_subsurface(surface)) {
+    struct wlr_subsurface *subsurface =
+        wlr_subsurface_from_wlr_surface(surface);
+
+    x += subsurface->current.x;
+    y += subsurface->current.y;
+    surface = subsurface->parent;
+  }
+
+  if (surface == NULL || surface != view_child->parent->surface) {
+    return false;
+  }
+
+  *sx = x;
+  *sy = y;
+
+  return true;
+}
+
 static void
 commit_child_handler(struct wl_listener *listener, void *data)
 {
@@ -1651,11 +1796,42 @@ commit_child_handler(struct wl_listener *listener, void *data)
       wl_container_of(listener, view_child, commit);
 
   struct hikari_view *parent = view_child->parent;
+  struct wlr_surface *surface = view_child->surface;
+  int sx, sy;
+  bool nested = child_offset(view_child, &sx, &sy);
+
+  if (nested) {
+    hikari_surface_cache_commit(&parent->surface_cache, surface, sx, sy);
+  } else {
+    hikari_surface_cache_invalidate(&parent->surface_cache);
+  }
 
-  if (!hikari_view_is_hidden(parent)) {
-    struct wlr_surface *surface = view_child->surface;
+  if (hikari_view_is_hidden(parent)) {
+    return;
+  }
 
+  if (parent->use_csd || !nested) {
     hikari_view_damage_surface(parent, surface, false);
+    return;
+  }
+
+  struct hikari_damage_data damage_data;
+
+  damage_data.geometry = hikari_view_geometry(parent);
+  damage_data.output = parent->output;
+  damage_data.view = parent;
+
+  if (sx != view_child->sx || sy != view_child->sy) {
+    damage_whole_surface(surface, view_child->sx, view_child->sy, &damage_data);
+    damage_whole_surface(surface, sx, sy, &damage_data);
+
+    view_child->sx = sx;
+    view_child->sy = sy;
+  } else {
+    struct wlr_box *geometry = damage_data.geometry;
+
+    hikari_output_add_effective_surface_damage(
+        parent->output, surface, geometry->x + sx, geometry->y + sy);
   }
 }
 
@@ -1664,7 +1840,7 @@ view_subsurface_create(
     struct wlr_subsurface *wlr_subsurface, struct hikari_view *parent)
 {
   struct hikari_view_subsurface *view_subsurface =
-      hikari_malloc(sizeof(struct hikari_view_subsurface));
+      hikari_slab_alloc(&hikari_view_subsurface_slab);
 
   hikari_view_subsurface_init(view_subsurface, parent, wlr_subsurface);
 }
@@ -1688,6 +1864,11 @@ hikari_view_child_init(struct hikari_view_child *view_child,
   view_child->parent = parent;
   view_child->surface = surface;
 
+  if (!child_offset(view_child, &view_child->sx, &view_child->sy)) {
+    view_child->sx = 0;
+    view_child->sy = 0;
+  }
+
   view_child->new_subsurface.notify = new_subsurface_child_handler;
   wl_signal_add(&surface->events.new_subsurface, &view_child->new_subsurface);
 
@@ -1695,6 +1876,8 @@ hikari_view_child_init(struct hikari_view_child *view_child,
   wl_signal_add(&surface->events.commit, &view_child->commit);
 
   wl_list_insert(&parent->children, &view_child->link);
+  hikari_surface_cache_invalidate(&parent->surface_cache);
+  hikari_stacking_invalidate();
 
   struct wlr_subsurface *subsurface;
   wl_list_for_each (
@@ -1778,6 +1961,21 @@ commit_operation(struct hikari_operation *operation, struct hikari_view *view)
   }
 }
 
+void
+hikari_view_commit_surface(struct hikari_view *view)
+{
+  struct wlr_surface *surface = view->surface;
+
+  if (surface == NULL) {
+    return;
+  }
+
+  if (surface->current.width != surface->previous.width ||
+      surface->current.height != surface->previous.height) {
+    hikari_stacking_invalidate();
+  }
+}
+
 void
 hikari_view_commit_pending_operation(
     struct hikari_view *view, struct wlr_box *geometry)
@@ -1832,6 +2030,8 @@ hikari_view_migrate(struct hikari_view *view,
   struct hikari_output *output = sheet->workspace->output;
   struct wlr_box *view_geometry = hikari_view_geometry(view);
 
+  hikari_placement_forget(view);
+
   hikari_indicator_damage(&hikari_server.indicator, view);
   hikari_view_damage_whole(view);
 
@@ -0,0 +1,321 @@
+#include <hikari/view_index.h>
+
+#include <assert.h>
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <hikari/group.h>
+#include <hikari/memory.h>
+#include <hikari/view.h>
+
+#define MAX_GRAMS (HIKARI_VIEW_INDEX_TEXT_SIZE * 3)
+
+static inline uint32_t
+make_gram(const char *text, int len)
+{
+  uint32_t gram = (uint32_t)len << 24;
+
+  for (int i = 0; i < len; i++) {
+    gram |= (uint32_t)(unsigned char)text[i] << (16 - 8 * i);
+  }
+
+  return gram;
+}
+
+static inline struct hikari_view_index_postings **
+bucket(struct hikari_view_index *index, uint32_t gram)
+{
+  uint32_t hash = (gram * 2654435761u) >> 20;
+
+  return &index->buckets[hash % HIKARI_VIEW_INDEX_BUCKETS];
+}
+
+static struct hikari_view_index_postings *
+find_postings(struct hikari_view_index *index, uint32_t gram)
+{
+  struct hikari_view_index_postings *postings = *bucket(index, gram);
+
+  while (postings != NULL && postings->gram != gram) {
+    postings = postings->next;
+  }
+
+  return postings;
+}
+
+static void
+add_posting(struct hikari_view_index *index,
+    uint32_t gram,
+    struct hikari_view_index_entry *entry)
+{
+  struct hikari_view_index_postings *postings = find_postings(index, gram);
+
+  if (postings == NULL) {
+    struct hikari_view_index_postings **head = bucket(index, gram);
+
+    postings = hikari_malloc(sizeof(struct hikari_view_index_postings));
+    postings->gram = gram;
+    postings->entries = NULL;
+    postings->nr_of_entries = 0;
+    postings->capacity = 0;
+    postings->next = *head;
+    *head = postings;
+  }
+
+  if (postings->nr_of_entries == postings->capacity) {
+    int capacity = postings->capacity == 0 ? 4 : postings->capacity * 2;
+    struct hikari_view_index_entry **entries =
+        hikari_malloc(capacity * sizeof(struct hikari_view_index_entry *));
+
+    if (postings->entries != NULL) {
+      memcpy(entries,
+          postings->entries,
+          postings->nr_of_entries * sizeof(struct hikari_view_index_entry *));
+      hikari_free(postings->entries);
+    }
+
+    postings->entries = entries;
+    postings->capacity = capacity;
+  }
+
+  postings->entries[postings->nr_of_entries++] = entry;
+}
+
+static void
+remove_posting(struct hikari_view_index *index,
+    uint32_t gram,
+    struct hikari_view_index_entry *entry)
+{
+  struct hikari_view_index_postings **link = bucket(index, gram);
+  struct hikari_view_index_postings *postings = *link;
+
+  while (postings != NULL && postings->gram != gram) {
+    link = &postings->next;
+    postings = postings->next;
+  }
+
+  assert(postings != NULL);
+
+  for (int i = 0; i < postings->nr_of_entries; i++) {
+    if (postings->entries[i] == entry) {
+      postings->entries[i] = postings->entries[--postings->nr_of_entries];
+      break;
+    }
+  }
+
+  if (postings->nr_of_entries == 0) {
+    *link = postings->next;
+    hikari_free(postings->entries);
+    hikari_free(postings);
+  }
+}
+
+static int
+compare_grams(const void *a, const void *b)
+{
+  uint32_t x = *(const uint32_t *)a;
+  uint32_t y = *(const uint32_t *)b;
+
+  return (x > y) - (x < y);
+}
+
+static int
+collect_grams(const char *text, uint32_t *grams)
+{
+  int nr_of_grams = 0;
+  int len = strlen(text);
+
+  for (int i = 0; i < len; i++) {
+    for (int n = 1; n <= 3 && i + n <= len; n++) {
+      if (text[i + n - 1] == '\n') {
+        break;
+      }
+
+      grams[nr_of_grams++] = make_gram(text + i, n);
+    }
+  }
+
+  qsort(grams, nr_of_grams, sizeof(uint32_t), compare_grams);
+
+  int unique = 0;
+  for (int i = 0; i < nr_of_grams; i++) {
+    if (unique == 0 || grams[unique - 1] != grams[i]) {
+      grams[unique++] = grams[i];
+    }
+  }
+
+  return unique;
+}
+
+static void
+lowercase(char *text)
+{
+  for (char *c = text; *c != '\0'; c++) {
+    *c = tolower((unsigned char)*c);
+  }
+}
+
+static void
+describe(struct hikari_view *view, char *text)
+{
+  snprintf(text,
+      HIKARI_VIEW_INDEX_TEXT_SIZE,
+      "%s\n%s\n%s",
+      view->title != NULL ? view->title : "",
+      view->id != NULL ? view->id : "",
+      view->group != NULL ? view->group->name : "");
+
+  lowercase(text);
+}
+
+void
+hikari_view_index_init(struct hikari_view_index *index)
+{
+  for (int i = 0; i < HIKARI_VIEW_INDEX_BUCKETS; i++) {
+    index->buckets[i] = NULL;
+  }
+
+  wl_list_init(&index->entries);
+  index->generation = 0;
+}
+
+void
+hikari_view_index_fini(struct hikari_view_index *index)
+{
+  struct hikari_view_index_entry *entry, *entry_temp;
+  wl_list_for_each_safe (entry, entry_temp, &index->entries, index_entries) {
+    hikari_view_index_remove(index, entry->view);
+  }
+}
+
+void
+hikari_view_index_update(
+    struct hikari_view_index *index, struct hikari_view *view)
+{
+  struct hikari_view_index_entry *entry = view->index_entry;
+  char text[HIKARI_VIEW_INDEX_TEXT_SIZE];
+
+  describe(view, text);
+
+  if (entry == NULL) {
+    entry = hikari_malloc(sizeof(struct hikari_view_index_entry));
+    entry->view = view;
+    entry->text[0] = '\0';
+    entry->grams = NULL;
+    entry->nr_of_grams = 0;
+
+    wl_list_insert(index->entries.prev, &entry->index_entries);
+    view->index_entry = entry;
+    index->generation++;
+  } else if (!strcmp(entry->text, text)) {
+    return;
+  }
+
+  uint32_t grams[MAX_GRAMS];
+  int nr_of_grams = collect_grams(text, grams);
+
+  int i = 0;
+  int j = 0;
+  while (i < entry->nr_of_grams || j < nr_of_grams) {
+    if (j == nr_of_grams ||
+        (i < entry->nr_of_grams && entry->grams[i] < grams[j])) {
+      remove_posting(index, entry->grams[i++], entry);
+    } else if (i == entry->nr_of_grams || grams[j] < entry->grams[i]) {
+      add_posting(index, grams[j++], entry);
+    } else {
+      i++;
+      j++;
+    }
+  }
+
+  hikari_free(entry->grams);
+  entry->grams = hikari_malloc(nr_of_grams * sizeof(uint32_t));
+  memcpy(entry->grams, grams, nr_of_grams * sizeof(uint32_t));
+  entry->nr_of_grams = nr_of_grams;
+
+  strcpy(entry->text, text);
+}
+
+void
+hikari_view_index_remove(
+    struct hikari_view_index *index, struct hikari_view *view)
+{
+  struct hikari_view_index_entry *entry = view->index_entry;
+
+  if (entry == NULL) {
+    return;
+  }
+
+  for (int i = 0; i < entry->nr_of_grams; i++) {
+    remove_posting(index, entry->grams[i], entry);
+  }
+
+  wl_list_remove(&entry->index_entries);
+  hikari_free(entry->grams);
+  hikari_free(entry);
+
+  view->index_entry = NULL;
+  index->generation++;
+}
+
+int
+hikari_view_index_search(struct hikari_view_index *index,
+    const char *query,
+    struct hikari_view **results,
+    int max)
+{
+  char needle[HIKARI_VIEW_INDEX_TEXT_SIZE];
+  int nr_of_results = 0;
+
+  snprintf(needle, sizeof(needle), "%s", query);
+  lowercase(needle);
+
+  int len = strlen(needle);
+
+  if (len == 0) {
+    struct hikari_view_index_entry *entry;
+    wl_list_for_each (entry, &index->entries, index_entries) {
+      if (nr_of_results == max) {
+        break;
+      }
+
+      results[nr_of_results++] = entry->view;
+    }
+
+    return nr_of_results;
+  }
+
+  struct hikari_view_index_postings *postings = NULL;
+
+  if (len <= 3) {
+    postings = find_postings(index, make_gram(needle, len));
+  } else {
+    for (int i = 0; i + 3 <= len; i++) {
+      struct hikari_view_index_postings *candidates =
+          find_postings(index, make_gram(needle + i, 3));
+
+      if (candidates == NULL) {
+        return 0;
+      }
+
+      if (postings == NULL ||
+          candidates->nr_of_entries < postings->nr_of_entries) {
+        postings = candidates;
+      }
+    }
+  }
+
+  if (postings == NULL) {
+    return 0;
+  }
+
+  for (int i = 0; i < postings->nr_of_entries && nr_of_results < max; i++) {
+    struct hikari_view_index_entry *entry = postings->entries[i];
+
+    if (len <= 3 || strstr(entry->text, needle) != NULL) {
+      results[nr_of_results++] = entry->view;
+    }
+  }
+
+  return nr_of_results;
+}
@@ -0,0 +1,99 @@
+#include <hikari/view_table.h>
+
+#include <string.h>
+
+#include <hikari/memory.h>
+
+void
+hikari_view_table_init(struct hikari_view_table *view_table)
+{
+  view_table->entries = NULL;
+  view_table->nr_of_entries = 0;
+  view_table->capacity = 0;
+  view_table->next_serial = 1;
+}
+
+void
+hikari_view_table_fini(struct hikari_view_table *view_table)
+{
+  hikari_free(view_table->entries);
+}
+
+// serials are handed out in increasing order and never reused, so appending
+// keeps the entries sorted
+static int
+find_entry(struct hikari_view_table *view_table, uint32_t serial)
+{
+  int low = 0;
+  int high = view_table->nr_of_entries - 1;
+
+  while (low <= high) {
+    int mid = low + (high - low) / 2;
+    uint32_t current = view_table->entries[mid].serial;
+
+    if (current == serial) {
+      return mid;
+    } else if (current < serial) {
+      low = mid + 1;
+    } else {
+      high = mid - 1;
+    }
+  }
+
+  return -1;
+}
+
+uint32_t
+hikari_view_table_insert(
+    struct hikari_view_table *view_table, struct hikari_view *view)
+{
+  if (view_table->nr_of_entries == view_table->capacity) {
+    int capacity = view_table->capacity == 0 ? 64 : view_table->capacity * 2;
+    struct hikari_view_table_entry *entries =
+        hikari_calloc(capacity, sizeof(struct hikari_view_table_entry));
+
+    if (view_table->nr_of_entries > 0) {
+      memcpy(entries,
+          view_table->entries,
+          view_table->nr_of_entries * sizeof(struct hikari_view_table_entry));
+    }
+
+    hikari_free(view_table->entries);
+    view_table->entries = entries;
+    view_table->capacity = capacity;
+  }
+
+  uint32_t serial = view_table->next_serial++;
+  struct hikari_view_table_entry *entry =
+      &view_table->entries[view_table->nr_of_entries++];
+
+  entry->serial = serial;
+  entry->view = view;
+
+  return serial;
+}
+
+void
+hikari_view_table_remove(struct hikari_view_table *view_table, uint32_t serial)
+{
+  int index = find_entry(view_table, serial);
+
+  if (index == -1) {
+    return;
+  }
+
+  memmove(&view_table->entries[index],
+      &view_table->entries[index + 1],
+      (view_table->nr_of_entries - index - 1) *
+          sizeof(struct hikari_view_table_entry));
+
+  view_table->nr_of_entries--;
+}
+
+struct hikari_view *
+hikari_view_table_lookup(struct hikari_view_table *view_table, uint32_t serial)
+{
+  int index = find_entry(view_table, serial);
+
+  return index != -1 ? view_table->entries[index].view : NULL;
+}
@@ -23,6 +23,7 @@
 #include <hikari/normal_mode.h>
 #include <hikari/server.h>
 #include <hikari/sheet.h>
+#include <hikari/split.h>
 #include <hikari/xdg_view.h>
 #ifdef HAVE_XWAYLAND
 #include <hikari/xwayland_unmanaged_view.h>
@@ -42,6 +43,7 @@ hikari_workspace_init(
 {
   wl_list_init(&workspace->views);
   wl_list_init(&hikari_server.visible_groups);
+  hikari_stacking_init(&workspace->stacking);
   workspace->output = output;
   workspace->focus_view = NULL;
   workspace->sheets =
@@ -62,6 +64,7 @@ hikari_workspace_init(
 void
 hikari_workspace_fini(struct hikari_workspace *workspace)
 {
+  hikari_stacking_fini(&workspace->stacking);
   hikari_free(workspace->sheets);
 }
 
@@ -89,12 +92,28 @@ hikari_workspace_merge(
   printf("WORKSPACE MERGE %p INTO %p\n", workspace, into);
 #endif
 
+  bool noop = into->output == hikari_server.noop_output;
+
   for (int i = 0; i < HIKARI_NR_OF_SHEETS; i++) {
     struct hikari_sheet *from = &workspace->sheets[i];
     struct hikari_sheet *to = &into->sheets[i];
+    struct hikari_split *split = NULL;
+
+    if (!noop && to == into->sheet && from->layout != NULL) {
+      struct hikari_layout *layout =
+          to->layout != NULL ? to->layout : from->layout;
+
+      split = hikari_split_copy(layout->split);
+    }
+
     struct hikari_view *view, *view_temp;
     wl_list_for_each_reverse_safe (view, view_temp, &from->views, sheet_views) {
-      hikari_view_evacuate(view, to);
+      hikari_view_evacuate(view, to, split != NULL);
+    }
+
+    if (split != NULL) {
+      hikari_sheet_retile(to, split);
+      hikari_split_free(split);
     }
   }
 
@@ -108,6 +127,8 @@ hikari_workspace_merge(
     hikari_xwayland_unmanaged_evacuate(unmanaged_xwayland_view, into);
   }
 #endif
+
+  hikari_output_damage_whole(into->output);
 }
 
 void
@@ -165,6 +186,10 @@ display_sheet(struct hikari_workspace *workspace, struct hikari_sheet *sheet)
   }
 
   hikari_server_cursor_focus();
+
+#ifdef HAVE_IPC
+  hikari_ipc_notify_sheet(&hikari_server.ipc, sheet);
+#endif
 }
 
 #define DISPLAY_SHEET(name, sheet)                                             \
@@ -428,6 +453,10 @@ hikari_workspace_focus_view(
 
   hikari_server.workspace = workspace;
   workspace->focus_view = view;
+
+#ifdef HAVE_IPC
+  hikari_ipc_notify_focus(&hikari_server.ipc, view);
+#endif
 }
 
 void
@@ -19,6 +19,8 @@
 #include <hikari/output.h>
 #include <hikari/server.h>
 #include <hikari/sheet.h>
+#include <hikari/slab.h>
+#include <hikari/trace.h>
 #include <hikari/view.h>
 #include <hikari/view_config.h>
 #include <hikari/workspace.h>
@@ -42,6 +44,13 @@ set_title_handler(struct wl_listener *listener, void *data)
 static void
 commit_handler(struct wl_listener *listener, void *data)
 {
+  HIKARI_TRACE_SCOPE("xdg_view_commit");
+
+#ifdef HAVE_RECORD
+  hikari_recorder_mark(
+      &hikari_server.recorder, HIKARI_RECORDER_EVENT_COMMIT, 0, 0, 0);
+#endif
+
   struct hikari_xdg_view *xdg_view =
       wl_container_of(listener, xdg_view, commit);
 
@@ -51,6 +60,9 @@ commit_handler(struct wl_listener *listener, void *data)
 
   assert(view->surface != NULL);
 
+  hikari_surface_cache_commit(&view->surface_cache, surface->surface, 0, 0);
+  hikari_view_commit_surface(view);
+
   if (hikari_view_was_updated(view, serial)) {
     struct wlr_box new_geometry;
     wlr_xdg_surface_get_geometry(surface, &new_geometry);
@@ -146,8 +158,6 @@ static struct wlr_surface *
 surface_at(
     struct hikari_node *node, double ox, double oy, double *sx, double *sy)
 {
-  struct hikari_xdg_view *xdg_view = (struct hikari_xdg_view *)node;
-
   struct hikari_view *view = (struct hikari_view *)node;
 
   struct wlr_box *geometry = hikari_view_geometry(view);
@@ -155,7 +165,8 @@ surface_at(
   double x = ox - geometry->x;
   double y = oy - geometry->y;
 
-  return wlr_xdg_surface_surface_at(xdg_view->surface, x, y, sx, sy);
+  return hikari_surface_cache_surface_at(
+      &view->surface_cache, node, x, y, sx, sy);
 }
 
 static void
@@ -276,7 +287,7 @@ destroy_handler(struct wl_listener *listener, void *data)
   wl_list_remove(&xdg_view->destroy.link);
 
   hikari_view_fini(view);
-  hikari_free(xdg_view);
+  hikari_slab_free(&hikari_xdg_view_slab, xdg_view);
 }
 
 static void
@@ -312,7 +323,7 @@ destroy_popup_handler(struct wl_listener *listener, void *data)
   wl_list_remove(&popup->map.link);
   wl_list_remove(&popup->new_popup.link);
 
-  hikari_free(popup);
+  hikari_slab_free(&hikari_xdg_popup_slab, popup);
 }
 
 static void
@@ -352,6 +363,7 @@ popup_map(struct wl_listener *listener, void *data)
 
   struct hikari_view *parent = xdg_popup->view_child.parent;
 
+  hikari_surface_cache_invalidate(&parent->surface_cache);
   hikari_view_damage_surface(parent, xdg_popup->view_child.surface, true);
 }
 
@@ -367,6 +379,7 @@ popup_unmap(struct wl_listener *listener, void *data)
 
   struct hikari_view *parent = xdg_popup->view_child.parent;
 
+  hikari_surface_cache_invalidate(&parent->surface_cache);
   hikari_view_damage_surface(parent, xdg_popup->view_child.surface, true);
 }
 
@@ -394,7 +407,7 @@ static void
 xdg_popup_create(struct wlr_xdg_popup *wlr_popup, struct hikari_view *parent)
 {
   struct hikari_xdg_popup *popup =
-      hikari_malloc(sizeof(struct hikari_xdg_popup));
+      hikari_slab_alloc(&hikari_xdg_popup_slab);
 
 #if !defined(NDEBUG)
   printf("CREATE POPUP\n");
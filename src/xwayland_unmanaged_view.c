@@ -6,6 +6,7 @@
 #include <hikari/memory.h>
 #include <hikari/output.h>
 #include <hikari/server.h>
+#include <hikari/slab.h>
 #include <hikari/workspace.h>
 
 static bool
@@ -129,7 +130,8 @@ destroy_handler(struct wl_listener *listener, void *data)
   wl_list_remove(&xwayland_unmanaged_view->destroy.link);
   wl_list_remove(&xwayland_unmanaged_view->request_configure.link);
 
-  hikari_free(xwayland_unmanaged_view);
+  hikari_slab_free(
+      &hikari_xwayland_unmanaged_view_slab, xwayland_unmanaged_view);
 }
 
 static void
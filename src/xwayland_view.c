@@ -13,6 +13,8 @@
 #include <hikari/output.h>
 #include <hikari/server.h>
 #include <hikari/sheet.h>
+#include <hikari/slab.h>
+#include <hikari/trace.h>
 #include <hikari/view.h>
 #include <hikari/workspace.h>
 
@@ -68,12 +70,21 @@ move(struct hikari_view *view, int x, int y)
 static void
 commit_handler(struct wl_listener *listener, void *data)
 {
+  HIKARI_TRACE_SCOPE("xwayland_view_commit");
+
+#ifdef HAVE_RECORD
+  hikari_recorder_mark(
+      &hikari_server.recorder, HIKARI_RECORDER_EVENT_COMMIT, 0, 0, 0);
+#endif
+
   struct hikari_xwayland_view *xwayland_view =
       wl_container_of(listener, xwayland_view, commit);
 
   struct hikari_view *view = (struct hikari_view *)xwayland_view;
   struct wlr_box *geometry = hikari_view_geometry(view);
 
+  hikari_view_commit_surface(view);
+
   if (hikari_view_is_dirty(view)) {
     hikari_view_commit_pending_operation(
         view, &view->pending_operation.geometry);
@@ -256,7 +267,7 @@ destroy_handler(struct wl_listener *listener, void *data)
   wl_list_remove(&xwayland_view->request_configure.link);
   wl_list_remove(&xwayland_view->set_title.link);
 
-  hikari_free(xwayland_view);
+  hikari_slab_free(&hikari_xwayland_view_slab, xwayland_view);
 }
 
 static void